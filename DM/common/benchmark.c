@@ -0,0 +1,209 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "benchmark.h"
+
+// Quantile de la loi normale pour un intervalle de confiance à 95 %
+#define BENCH_Z95 1.96
+
+static double timespec_seconds(const struct timespec* t) {
+    return t->tv_sec + t->tv_nsec / 1e9;
+}
+
+// Temps réel monotone (insensible aux réglages de l'horloge système)
+double bench_wall_time(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return timespec_seconds(&t);
+}
+
+// Temps CPU consommé par le thread courant, à la nanoseconde (contrairement à clock())
+double bench_thread_cpu_time(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return timespec_seconds(&t);
+}
+
+static int env_int(const char* name, const int fallback) {
+    const char* value = getenv(name);
+    return value != NULL && *value != '\0' ? atoi(value) : fallback;
+}
+
+static double env_double(const char* name, const double fallback) {
+    const char* value = getenv(name);
+    return value != NULL && *value != '\0' ? atof(value) : fallback;
+}
+
+void bench_config_from_env(BenchConfig* config) {
+    config->warmup = env_int("BENCH_WARMUP", 1);
+    config->trials = env_int("BENCH_TRIALS", 11);
+    config->min_trials = env_int("BENCH_MIN_TRIALS", 1);
+    config->budget = env_double("BENCH_BUDGET", 1.0);
+    config->cpu = env_int("BENCH_CPU", -1);
+
+    if (config->warmup < 0) config->warmup = 0;
+    if (config->trials < 1) config->trials = 1;
+    if (config->trials > BENCH_MAX_TRIALS) config->trials = BENCH_MAX_TRIALS;
+    if (config->min_trials < 1) config->min_trials = 1;
+    if (config->min_trials > config->trials) config->min_trials = config->trials;
+}
+
+// Épingle le thread courant sur un cœur (moins de migrations, caches stables).
+// Retourne 0 en cas de succès.
+int bench_pin_cpu(const int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return -1;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    const double x = *(const double*)a;
+    const double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void bench_compute_stats(const double samples[], const int n, BenchStats* stats) {
+    double sorted[BENCH_MAX_TRIALS];
+    memcpy(sorted, samples, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), compare_doubles);
+
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += sorted[i];
+    }
+
+    stats->min = sorted[0];
+    stats->mean = sum / n;
+    stats->median = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+
+    // 95e centile, rang le plus proche
+    int p95 = (int)ceil(0.95 * n) - 1;
+    stats->p95 = sorted[p95 < 0 ? 0 : p95];
+
+    // Intervalle de la médiane: rangs n/2 -+ z*sqrt(n)/2 (approximation
+    // normale de la loi binomiale), ramenés dans [1, n]
+    const double half_width = BENCH_Z95 * sqrt(n) / 2;
+    int low = (int)floor(n / 2.0 - half_width);
+    int high = (int)ceil(1 + n / 2.0 + half_width);
+    if (low < 1) low = 1;
+    if (high > n) high = n;
+    stats->ci_low = sorted[low - 1];
+    stats->ci_high = sorted[high - 1];
+}
+
+void bench_measure(const BenchConfig* config, void (*setup)(void*), void (*body)(void*),
+                   void* context, BenchResult* result) {
+    double wall[BENCH_MAX_TRIALS];
+    double cpu[BENCH_MAX_TRIALS];
+
+    // Chauffe: caches, prédicteurs, pages du tas et fréquence du processeur.
+    // Une exécution qui dépasse déjà le budget suffit.
+    const double warmup_start = bench_wall_time();
+    for (int w = 0; w < config->warmup && bench_wall_time() - warmup_start < config->budget; w++) {
+        if (setup != NULL) setup(context);
+        body(context);
+    }
+
+    const double start = bench_wall_time();
+    int trials = 0;
+    while (trials < config->trials) {
+        if (setup != NULL) setup(context);
+
+        const double cpu_start = bench_thread_cpu_time();
+        const double wall_start = bench_wall_time();
+        body(context);
+        wall[trials] = bench_wall_time() - wall_start;
+        cpu[trials] = bench_thread_cpu_time() - cpu_start;
+        trials++;
+
+        if (trials >= config->min_trials && bench_wall_time() - start >= config->budget) break;
+    }
+
+    result->trials = trials;
+    bench_compute_stats(wall, trials, &result->wall);
+    bench_compute_stats(cpu, trials, &result->cpu);
+}
+
+static int ends_with(const char* text, const char* suffix) {
+    const size_t n = strlen(text);
+    const size_t m = strlen(suffix);
+    return n >= m && strcmp(text + n - m, suffix) == 0;
+}
+
+// Ouvre BENCH_OUTPUT s'il est défini; sinon le rapport reste inactif
+void bench_report_open(BenchReport* report) {
+    const char* path = getenv("BENCH_OUTPUT");
+    report->out = NULL;
+    report->format = BENCH_FORMAT_CSV;
+    report->records = 0;
+
+    if (path == NULL || *path == '\0') return;
+
+    report->out = fopen(path, "w");
+    if (report->out == NULL) {
+        fprintf(stderr, "Impossible d'ouvrir %s, pas de rapport\n", path);
+        return;
+    }
+
+    if (ends_with(path, ".json")) {
+        report->format = BENCH_FORMAT_JSON;
+        fprintf(report->out, "[\n");
+    } else {
+        fprintf(report->out, "suite,algorithm,input,size,trials,"
+                "wall_median,wall_p95,wall_ci_low,wall_ci_high,wall_min,wall_mean,"
+                "cpu_median,cpu_p95,cpu_ci_low,cpu_ci_high,cpu_min,cpu_mean\n");
+    }
+}
+
+static void write_stats_csv(FILE* out, const BenchStats* s) {
+    fprintf(out, ",%.9f,%.9f,%.9f,%.9f,%.9f,%.9f",
+            s->median, s->p95, s->ci_low, s->ci_high, s->min, s->mean);
+}
+
+static void write_stats_json(FILE* out, const char* name, const BenchStats* s) {
+    fprintf(out, "\"%s\": {\"median\": %.9f, \"p95\": %.9f, \"ci_low\": %.9f, "
+            "\"ci_high\": %.9f, \"min\": %.9f, \"mean\": %.9f}",
+            name, s->median, s->p95, s->ci_low, s->ci_high, s->min, s->mean);
+}
+
+// Une ligne (CSV) ou un objet (JSON) par mesure. Les noms ne doivent contenir
+// ni virgule ni guillemet.
+void bench_report_add(BenchReport* report, const BenchResult* result) {
+    if (report->out == NULL) return;
+
+    if (report->format == BENCH_FORMAT_JSON) {
+        fprintf(report->out, "%s  {\"suite\": \"%s\", \"algorithm\": \"%s\", \"input\": \"%s\", "
+                "\"size\": %ld, \"trials\": %d, ",
+                report->records > 0 ? ",\n" : "", result->suite, result->algorithm,
+                result->input, result->size, result->trials);
+        write_stats_json(report->out, "wall", &result->wall);
+        fprintf(report->out, ", ");
+        write_stats_json(report->out, "cpu", &result->cpu);
+        fprintf(report->out, "}");
+    } else {
+        fprintf(report->out, "%s,%s,%s,%ld,%d", result->suite, result->algorithm,
+                result->input, result->size, result->trials);
+        write_stats_csv(report->out, &result->wall);
+        write_stats_csv(report->out, &result->cpu);
+        fprintf(report->out, "\n");
+    }
+    report->records++;
+}
+
+void bench_report_close(BenchReport* report) {
+    if (report->out == NULL) return;
+
+    if (report->format == BENCH_FORMAT_JSON) {
+        fprintf(report->out, "\n]\n");
+    }
+    fclose(report->out);
+    report->out = NULL;
+}
@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+
+// Banc de mesure commun aux deux exercices (benchmark.c).
+//
+// Chaque mesure fait quelques exécutions de chauffe non mesurées, puis une
+// série d'essais chronométrés avec deux horloges: le temps réel monotone et
+// le temps CPU du thread appelant (pour un tri parallèle, ce dernier ne compte
+// que le thread appelant). On garde la médiane, le 95e centile et un
+// intervalle de confiance à 95 % de la médiane (statistiques d'ordre, sans
+// hypothèse de normalité).
+//
+// Réglages par variables d'environnement (bench_config_from_env):
+//   BENCH_WARMUP    exécutions de chauffe (défaut 1)
+//   BENCH_TRIALS    essais mesurés au plus (défaut 11)
+//   BENCH_BUDGET    secondes au-delà desquelles on arrête les essais, une fois
+//                   BENCH_MIN_TRIALS atteints (défaut 1.0)
+//   BENCH_MIN_TRIALS essais mesurés au moins (défaut 1)
+//   BENCH_CPU       cœur sur lequel épingler le thread de mesure (défaut: aucun)
+//   BENCH_OUTPUT    fichier de résultats; .json pour du JSON, sinon CSV
+//   BENCH_PERF      compteurs matériels par élément (voir perf_counters.h)
+//   BENCH_SEED      graine des listes générées (voir generator.h)
+
+#define BENCH_MAX_TRIALS 1000
+
+typedef struct {
+    int warmup;
+    int trials;
+    int min_trials;
+    double budget;
+    int cpu;
+} BenchConfig;
+
+// Résumé d'une série de mesures, en secondes
+typedef struct {
+    double median;
+    double p95;
+    double ci_low;
+    double ci_high;
+    double min;
+    double mean;
+} BenchStats;
+
+typedef struct {
+    const char* suite;
+    const char* algorithm;
+    const char* input;
+    long size;
+    int trials;
+    BenchStats wall;
+    BenchStats cpu;
+} BenchResult;
+
+typedef enum {
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+} BenchFormat;
+
+// Fichier de résultats lisible par machine (inactif si out == NULL)
+typedef struct {
+    FILE* out;
+    BenchFormat format;
+    int records;
+} BenchReport;
+
+double bench_wall_time(void);
+double bench_thread_cpu_time(void);
+
+void bench_config_from_env(BenchConfig* config);
+int bench_pin_cpu(int cpu);
+
+void bench_compute_stats(const double samples[], int n, BenchStats* stats);
+
+// Mesure body(context). setup(context), s'il est fourni, est appelé avant
+// chaque exécution (hors chronométrage), par exemple pour recopier l'entrée.
+// Remplit trials, wall et cpu de result; les noms restent à l'appelant.
+void bench_measure(const BenchConfig* config, void (*setup)(void*), void (*body)(void*),
+                   void* context, BenchResult* result);
+
+void bench_report_open(BenchReport* report);
+void bench_report_add(BenchReport* report, const BenchResult* result);
+void bench_report_close(BenchReport* report);
+
+#endif
@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "generator.h"
+
+// Éléments par bloc: chaque bloc a son propre générateur, dérivé de la graine
+#define GEN_CHUNK (1L << 16)
+#define GEN_MAX_THREADS 64
+
+// Exposant de la loi de Zipf (1: la valeur de rang k apparaît en proportion de 1/k)
+#define GEN_ZIPF_EXPONENT 1.0
+
+// Tours du réseau de Feistel de generate_distinct
+#define FEISTEL_ROUNDS 4
+
+static const char* pattern_names[GEN_NUM_PATTERNS] = {
+    "sorted", "reverse", "nearly_sorted", "random", "zipf",
+    "few_unique", "sawtooth", "organ_pipe", "duplicates"
+};
+
+// Fonction de mélange de splitmix64: bijective, avalanche complète
+static inline uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t rotl(const uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// L'état de xoshiro ne doit pas être nul: splitmix64 l'initialise à partir
+// d'une graine quelconque
+void rng_seed(Rng* rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9E3779B97F4A7C15ull;
+        rng->s[i] = mix64(seed);
+    }
+}
+
+// xoshiro256** (Blackman et Vigna)
+uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+// Méthode de Lemire: multiplication 64x64 -> 128 bits, rejet seulement dans
+// la petite zone qui créerait un biais (rarement plus d'un tirage)
+uint64_t rng_bounded(Rng* rng, const uint64_t bound) {
+    unsigned __int128 product = (unsigned __int128)rng_next(rng) * bound;
+    uint64_t low = (uint64_t)product;
+
+    if (low < bound) {
+        const uint64_t threshold = -bound % bound;
+        while (low < threshold) {
+            product = (unsigned __int128)rng_next(rng) * bound;
+            low = (uint64_t)product;
+        }
+    }
+    return (uint64_t)(product >> 64);
+}
+
+// 53 bits de poids fort: tous les doubles de [0, 1) au pas de 2^-53
+double rng_double(Rng* rng) {
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+void rng_shuffle(Rng* rng, int arr[], const long n) {
+    for (long i = n - 1; i > 0; i--) {
+        const long j = rng_bounded(rng, i + 1);
+        const int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+const char* generator_pattern_name(const GenPattern pattern) {
+    return pattern >= 0 && pattern < GEN_NUM_PATTERNS ? pattern_names[pattern] : "unknown";
+}
+
+int generator_pattern_from_name(const char* name) {
+    for (int p = 0; p < GEN_NUM_PATTERNS; p++) {
+        if (strcmp(name, pattern_names[p]) == 0) return p;
+    }
+    return -1;
+}
+
+uint64_t generator_default_seed(void) {
+    const char* value = getenv("BENCH_SEED");
+    if (value != NULL && *value != '\0') return strtoull(value, NULL, 0);
+
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    return mix64((uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec);
+}
+
+// Permutation pseudo-aléatoire de [0, range): réseau de Feistel sur le plus
+// petit domaine de 2^(2 * half_bits) valeurs qui contient la plage, puis
+// "cycle-walking": on réapplique la permutation tant que le résultat sort de
+// la plage. Le domaine fait moins de 4 fois la plage, donc moins de 4
+// applications en moyenne.
+typedef struct {
+    uint64_t range;
+    int half_bits;
+    uint64_t mask;
+    uint64_t keys[FEISTEL_ROUNDS];
+} Permutation;
+
+static void permutation_init(Permutation* perm, const uint64_t range, const uint64_t seed) {
+    int bits = 1;
+    while (bits < 64 && (1ull << bits) < range) bits++;
+
+    perm->range = range;
+    perm->half_bits = (bits + 1) / 2;
+    perm->mask = (1ull << perm->half_bits) - 1;
+    for (int r = 0; r < FEISTEL_ROUNDS; r++) {
+        perm->keys[r] = mix64(seed + 0x9E3779B97F4A7C15ull * (r + 1));
+    }
+}
+
+static inline uint64_t permutation_apply(const Permutation* perm, uint64_t x) {
+    do {
+        uint64_t left = x >> perm->half_bits;
+        uint64_t right = x & perm->mask;
+        for (int r = 0; r < FEISTEL_ROUNDS; r++) {
+            const uint64_t next = left ^ (mix64(right ^ perm->keys[r]) & perm->mask);
+            left = right;
+            right = next;
+        }
+        x = (left << perm->half_bits) | right;
+    } while (x >= perm->range);
+    return x;
+}
+
+// Loi de Zipf sur les rangs 1..n par rejet-inversion (Hörmann et Derflinger):
+// O(1) par tirage, sans table cumulative de taille n
+typedef struct {
+    double n;
+    double exponent;
+    double h_integral_x1;
+    double h_integral_n;
+    double s;
+} ZipfSampler;
+
+// log1p(x)/x et expm1(x)/x, prolongés par continuité en 0
+static double zipf_helper1(const double x) {
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x * (0.5 - x / 3);
+}
+
+static double zipf_helper2(const double x) {
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x * 0.5 * (1 + x / 3);
+}
+
+// Primitive de la densité x^-exponent
+static double zipf_h_integral(const ZipfSampler* z, const double x) {
+    const double log_x = log(x);
+    return zipf_helper2((1 - z->exponent) * log_x) * log_x;
+}
+
+static double zipf_h_integral_inverse(const ZipfSampler* z, const double x) {
+    double t = x * (1 - z->exponent);
+    if (t < -1) t = -1;
+    return exp(zipf_helper1(t) * x);
+}
+
+static double zipf_h(const ZipfSampler* z, const double x) {
+    return exp(-z->exponent * log(x));
+}
+
+static void zipf_init(ZipfSampler* z, const long n, const double exponent) {
+    z->n = n;
+    z->exponent = exponent;
+    z->h_integral_x1 = zipf_h_integral(z, 1.5) - 1;
+    z->h_integral_n = zipf_h_integral(z, n + 0.5);
+    z->s = 2 - zipf_h_integral_inverse(z, zipf_h_integral(z, 2.5) - zipf_h(z, 2));
+}
+
+static long zipf_sample(const ZipfSampler* z, Rng* rng) {
+    while (1) {
+        const double u = z->h_integral_n + rng_double(rng) * (z->h_integral_x1 - z->h_integral_n);
+        const double x = zipf_h_integral_inverse(z, u);
+        double k = floor(x + 0.5);
+        if (k < 1) k = 1;
+        else if (k > z->n) k = z->n;
+
+        if (k - x <= z->s || u >= zipf_h_integral(z, k + 0.5) - zipf_h(z, k)) return (long)k;
+    }
+}
+
+typedef struct {
+    int* arr;
+    long n;
+    GenPattern pattern;
+    uint64_t seed;
+    // GEN_RANDOM et generate_distinct: arr[i] = base + perm(i)
+    Permutation perm;
+    long long base;
+    ZipfSampler zipf;
+    int threads;
+    int thread_index;
+} FillJob;
+
+static void fill_chunk(const FillJob* job, const long chunk) {
+    const long begin = chunk * GEN_CHUNK;
+    const long end = begin + GEN_CHUNK < job->n ? begin + GEN_CHUNK : job->n;
+    const long n = job->n;
+    int* arr = job->arr;
+
+    Rng rng;
+    rng_seed(&rng, job->seed ^ mix64(chunk + 1));
+
+    switch (job->pattern) {
+        case GEN_SORTED:
+            for (long i = begin; i < end; i++) arr[i] = i;
+            break;
+        case GEN_REVERSE:
+            for (long i = begin; i < end; i++) arr[i] = n - 1 - i;
+            break;
+        case GEN_NEARLY_SORTED: {
+            for (long i = begin; i < end; i++) arr[i] = i;
+
+            // On permute 5% des éléments; les échanges restent dans le bloc
+            // pour que chaque bloc se génère indépendamment
+            const long permutations = (end - begin) * 0.05;
+            for (long p = 0; p < permutations; p++) {
+                const long pos1 = begin + rng_bounded(&rng, end - begin);
+                const long pos2 = begin + rng_bounded(&rng, end - begin);
+                const int temp = arr[pos1];
+                arr[pos1] = arr[pos2];
+                arr[pos2] = temp;
+            }
+            break;
+        }
+        case GEN_RANDOM:
+            for (long i = begin; i < end; i++) arr[i] = job->base + permutation_apply(&job->perm, i);
+            break;
+        case GEN_ZIPF:
+            for (long i = begin; i < end; i++) arr[i] = zipf_sample(&job->zipf, &rng) - 1;
+            break;
+        case GEN_FEW_UNIQUE: {
+            const long spacing = n / GEN_FEW_UNIQUE_VALUES > 0 ? n / GEN_FEW_UNIQUE_VALUES : 1;
+            for (long i = begin; i < end; i++) arr[i] = rng_bounded(&rng, GEN_FEW_UNIQUE_VALUES) * spacing;
+            break;
+        }
+        case GEN_SAWTOOTH: {
+            const long tooth = (n + GEN_SAWTOOTH_TEETH - 1) / GEN_SAWTOOTH_TEETH;
+            for (long i = begin; i < end; i++) arr[i] = i % tooth;
+            break;
+        }
+        case GEN_ORGAN_PIPE:
+            for (long i = begin; i < end; i++) arr[i] = i < (n + 1) / 2 ? i : n - 1 - i;
+            break;
+        case GEN_DUPLICATES: {
+            const uint64_t distinct = (uint64_t)sqrt((double)n) + 1;
+            for (long i = begin; i < end; i++) arr[i] = rng_bounded(&rng, distinct);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void* fill_worker(void* arg) {
+    const FillJob* job = arg;
+    const long chunks = (job->n + GEN_CHUNK - 1) / GEN_CHUNK;
+
+    for (long c = job->thread_index; c < chunks; c += job->threads) {
+        fill_chunk(job, c);
+    }
+    return NULL;
+}
+
+// Répartit les blocs entre les cœurs (le thread appelant prend sa part)
+static void run_fill(FillJob* job) {
+    const long chunks = (job->n + GEN_CHUNK - 1) / GEN_CHUNK;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > GEN_MAX_THREADS) threads = GEN_MAX_THREADS;
+    if (threads > chunks) threads = chunks;
+    if (threads < 1) threads = 1;
+
+    FillJob jobs[GEN_MAX_THREADS];
+    pthread_t workers[GEN_MAX_THREADS];
+    int started = 0;
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = *job;
+        jobs[t].threads = threads;
+        jobs[t].thread_index = t;
+    }
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, fill_worker, &jobs[t]) != 0) break;
+        started = t;
+    }
+
+    // Les blocs des threads qui n'ont pas pu démarrer sont faits ici
+    for (int t = started + 1; t < threads; t++) {
+        fill_worker(&jobs[t]);
+    }
+    fill_worker(&jobs[0]);
+
+    for (int t = 1; t <= started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+}
+
+void generate_pattern(int arr[], const long n, const GenPattern pattern, const uint64_t seed) {
+    if (n <= 0) return;
+
+    FillJob job;
+    memset(&job, 0, sizeof(job));
+    job.arr = arr;
+    job.n = n;
+    job.pattern = pattern;
+    job.seed = seed;
+
+    if (pattern == GEN_RANDOM) {
+        permutation_init(&job.perm, n, seed);
+    } else if (pattern == GEN_ZIPF) {
+        zipf_init(&job.zipf, n, GEN_ZIPF_EXPONENT);
+    }
+    run_fill(&job);
+}
+
+int generate_distinct(int arr[], const long n, const long long min_val, const long long max_val,
+                      const uint64_t seed) {
+    if (max_val < min_val || max_val - min_val + 1 < n) return -1;
+    if (n <= 0) return 0;
+
+    FillJob job;
+    memset(&job, 0, sizeof(job));
+    job.arr = arr;
+    job.n = n;
+    job.pattern = GEN_RANDOM;
+    job.seed = seed;
+    job.base = min_val;
+    permutation_init(&job.perm, max_val - min_val + 1, seed);
+    run_fill(&job);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdint.h>
+
+// Générateur de listes de test commun aux deux exercices (generator.c).
+//
+// Pseudo-aléatoire xoshiro256** (initialisé par splitmix64): rapide, de bonne
+// qualité statistique et reproductible à graine égale, contrairement à rand().
+// Les listes sont générées par blocs de taille fixe, chacun avec son propre
+// générateur dérivé de la graine: le résultat ne dépend que de la graine,
+// pas du nombre de threads, et les très grandes listes se remplissent en
+// parallèle.
+//
+// Graine: BENCH_SEED si défini (mesures reproductibles), sinon l'horloge.
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng* rng, uint64_t seed);
+uint64_t rng_next(Rng* rng);
+// Entier uniforme dans [0, bound), sans le biais du modulo
+uint64_t rng_bounded(Rng* rng, uint64_t bound);
+// Réel uniforme dans [0, 1)
+double rng_double(Rng* rng);
+// Mélange de Fisher-Yates uniforme
+void rng_shuffle(Rng* rng, int arr[], long n);
+
+typedef enum {
+    GEN_SORTED,         // 0, 1, ..., n-1
+    GEN_REVERSE,        // n-1, ..., 1, 0
+    GEN_NEARLY_SORTED,  // triée, puis 5 % d'échanges (à l'intérieur de blocs de 65536)
+    GEN_RANDOM,         // permutation aléatoire de 0..n-1
+    GEN_ZIPF,           // rangs 0..n-1 tirés selon une loi de Zipf (exposant 1)
+    GEN_FEW_UNIQUE,     // GEN_FEW_UNIQUE_VALUES valeurs distinctes
+    GEN_SAWTOOTH,       // GEN_SAWTOOTH_TEETH suites croissantes
+    GEN_ORGAN_PIPE,     // croissante jusqu'au milieu, puis décroissante
+    GEN_DUPLICATES,     // environ sqrt(n) valeurs distinctes, chacune très répétée
+    GEN_NUM_PATTERNS
+} GenPattern;
+
+#define GEN_FEW_UNIQUE_VALUES 16
+#define GEN_SAWTOOTH_TEETH 16
+
+// Nom d'un motif ("sorted", "zipf", ...) et réciproque (-1 si inconnu)
+const char* generator_pattern_name(GenPattern pattern);
+int generator_pattern_from_name(const char* name);
+
+uint64_t generator_default_seed(void);
+
+// Remplit arr[0..n) selon le motif (en parallèle pour les grandes listes)
+void generate_pattern(int arr[], long n, GenPattern pattern, uint64_t seed);
+
+// n valeurs distinctes de [min_val, max_val], dans un ordre aléatoire.
+// Temps O(n) et mémoire O(1) quelle que soit la plage (permutation pseudo-
+// aléatoire de la plage, pas de table des valeurs déjà tirées).
+// Retourne -1 si la plage contient moins de n valeurs.
+int generate_distinct(int arr[], long n, long long min_val, long long max_val, uint64_t seed);
+
+#endif
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "perf_counters.h"
+
+typedef struct {
+    const char* name;
+    unsigned int type;
+    unsigned long long config;
+} PerfEventSpec;
+
+#define CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+// Dans l'ordre de PerfEvent
+static const PerfEventSpec event_specs[PERF_NUM_EVENTS] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"L1d-misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {"LLC-misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)}
+};
+
+int perf_enabled_from_env(void) {
+    const char* value = getenv("BENCH_PERF");
+    return value != NULL && *value != '\0' && strcmp(value, "0") != 0;
+}
+
+const char* perf_event_name(const PerfEvent event) {
+    return event_specs[event].name;
+}
+
+static int open_event(const PerfEventSpec* spec) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec->type;
+    attr.config = spec->config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Si le noyau doit partager les compteurs, on corrige par le temps actif
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Thread courant, n'importe quel cœur
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int perf_counters_open(PerfCounters* counters) {
+    counters->available = 0;
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        counters->fds[e] = open_event(&event_specs[e]);
+        if (counters->fds[e] >= 0) counters->available++;
+    }
+    return counters->available;
+}
+
+void perf_counters_start(PerfCounters* counters) {
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (counters->fds[e] < 0) continue;
+        ioctl(counters->fds[e], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fds[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perf_counters_stop(PerfCounters* counters, PerfSample* sample) {
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (counters->fds[e] >= 0) {
+            ioctl(counters->fds[e], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        sample->valid[e] = 0;
+        sample->values[e] = 0;
+        if (counters->fds[e] < 0) continue;
+
+        // valeur, temps activé, temps réellement compté
+        unsigned long long data[3];
+        if (read(counters->fds[e], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+
+        sample->values[e] = data[2] < data[1] ? (double)data[0] * data[1] / data[2] : (double)data[0];
+        sample->valid[e] = 1;
+    }
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (counters->fds[e] >= 0) close(counters->fds[e]);
+        counters->fds[e] = -1;
+    }
+    counters->available = 0;
+}
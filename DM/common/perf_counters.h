@@ -0,0 +1,41 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Compteurs matériels Linux (perf_event_open), pour savoir si un tri est
+// limité par la mémoire ou par les erreurs de prédiction (perf_counters.c).
+//
+// Optionnel: activé par BENCH_PERF=1. Chaque compteur est ouvert séparément;
+// un compteur absent (machine virtuelle, perf_event_paranoid trop élevé,
+// processeur sans cet événement) est simplement marqué indisponible.
+// Seul le thread qui mesure est compté: les workers d'un tri parallèle n'y
+// figurent pas.
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_NUM_EVENTS
+} PerfEvent;
+
+typedef struct {
+    int fds[PERF_NUM_EVENTS];
+    int available;
+} PerfCounters;
+
+typedef struct {
+    double values[PERF_NUM_EVENTS];
+    int valid[PERF_NUM_EVENTS];
+} PerfSample;
+
+int perf_enabled_from_env(void);
+const char* perf_event_name(PerfEvent event);
+
+// Retourne le nombre de compteurs ouverts (0: rien n'est disponible)
+int perf_counters_open(PerfCounters* counters);
+void perf_counters_start(PerfCounters* counters);
+void perf_counters_stop(PerfCounters* counters, PerfSample* sample);
+void perf_counters_close(PerfCounters* counters);
+
+#endif
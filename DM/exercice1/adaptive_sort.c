@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri_composite.h"
+
+#define MIN_GALLOP 7
+#define MAX_RUN_STACK 64
+
+// Tri adaptatif par fusion de séquences naturelles (Timsort, politique de
+// fusion Powersort de Munro & Wild). Les séquences déjà croissantes ou
+// strictement décroissantes de l'entrée sont détectées et réutilisées telles
+// quelles: une liste triée ou inversée coûte n - 1 comparaisons.
+
+typedef struct {
+    int start;
+    int length;
+    int power;
+} Run;
+
+// Longueur minimale d'une séquence: entre 32 et 64, choisie pour que n / minrun
+// soit proche d'une puissance de deux (comme Timsort)
+static int compute_min_run(int n) {
+    int low_bits = 0;
+    while (n >= 64) {
+        low_bits |= n & 1;
+        n >>= 1;
+    }
+    return n + low_bits;
+}
+
+static void reverse_range(int arr[], int low, int high) {
+    while (low < high) {
+        const int temp = arr[low];
+        arr[low++] = arr[high];
+        arr[high--] = temp;
+        COUNT_SWAP();
+    }
+}
+
+// Longueur de la séquence naturelle qui commence en arr[low] (au plus
+// jusqu'à high exclu). Une séquence strictement décroissante est inversée
+// sur place; le « strictement » garantit la stabilité.
+static int count_run(int arr[], const int low, const int high) {
+    if (low + 1 == high) return 1;
+
+    int run_high = low + 2;
+    if (COUNT_COMPARISON(arr[low + 1] < arr[low])) {
+        while (run_high < high && COUNT_COMPARISON(arr[run_high] < arr[run_high - 1])) {
+            run_high++;
+        }
+        reverse_range(arr, low, run_high - 1);
+    } else {
+        while (run_high < high && !COUNT_COMPARISON(arr[run_high] < arr[run_high - 1])) {
+            run_high++;
+        }
+    }
+    return run_high - low;
+}
+
+// Tri par insertion binaire de arr[low..high), sachant arr[low..start) déjà trié
+static void binary_insertion_sort(int arr[], const int low, const int high, int start) {
+    for (; start < high; start++) {
+        const int pivot = arr[start];
+
+        // Premier élément > pivot (les égaux restent devant: stable)
+        int left = low;
+        int right = start;
+        while (left < right) {
+            const int mid = left + (right - left) / 2;
+            if (COUNT_COMPARISON(pivot < arr[mid])) right = mid; else left = mid + 1;
+        }
+
+        memmove(arr + left + 1, arr + left, (start - left) * sizeof(int));
+        arr[left] = pivot;
+        COUNT_SWAPS(start - left);
+    }
+}
+
+// Nombre d'éléments de arr[0..n) <= key (recherche exponentielle puis binaire)
+static int gallop_right(const int key, const int arr[], const int n) {
+    int last = 0;
+    int offset = 1;
+    while (offset <= n && !COUNT_COMPARISON(key < arr[offset - 1])) {
+        last = offset;
+        offset = 2 * offset;
+    }
+
+    int low = last;
+    int high = offset <= n ? offset - 1 : n;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (COUNT_COMPARISON(key < arr[mid])) high = mid; else low = mid + 1;
+    }
+    return low;
+}
+
+// Nombre d'éléments de arr[0..n) < key
+static int gallop_left(const int key, const int arr[], const int n) {
+    int last = 0;
+    int offset = 1;
+    while (offset <= n && COUNT_COMPARISON(arr[offset - 1] < key)) {
+        last = offset;
+        offset = 2 * offset;
+    }
+
+    int low = last;
+    int high = offset <= n ? offset - 1 : n;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (COUNT_COMPARISON(arr[mid] < key)) low = mid + 1; else high = mid;
+    }
+    return low;
+}
+
+// Fusion stable de arr[start..mid) et arr[mid..end). Le début de la séquence
+// gauche déjà à sa place et la fin de la droite ne sont pas copiés; quand un
+// côté gagne MIN_GALLOP fois de suite, on avance par recherche exponentielle.
+static void merge_runs(int arr[], int start, const int mid, int end, int temp[]) {
+    // Éléments de gauche <= arr[mid]: déjà à leur place
+    start += gallop_right(arr[mid], arr + start, mid - start);
+    if (start == mid) return;
+
+    // Éléments de droite >= arr[mid - 1]: déjà à leur place
+    end = mid + gallop_left(arr[mid - 1], arr + mid, end - mid);
+
+    const int left_length = mid - start;
+    memcpy(temp, arr + start, left_length * sizeof(int));
+    COUNT_SWAPS(left_length);
+
+    int i = 0;
+    int j = mid;
+    int k = start;
+
+    while (i < left_length && j < end) {
+        int left_wins = 0;
+        int right_wins = 0;
+
+        // Mode un par un
+        while (i < left_length && j < end && left_wins < MIN_GALLOP && right_wins < MIN_GALLOP) {
+            if (COUNT_COMPARISON(arr[j] < temp[i])) {
+                arr[k++] = arr[j++];
+                right_wins++;
+                left_wins = 0;
+            } else {
+                arr[k++] = temp[i++];
+                left_wins++;
+                right_wins = 0;
+            }
+            COUNT_SWAP();
+        }
+
+        // Mode galop: on copie des blocs entiers tant que c'est rentable
+        while (i < left_length && j < end) {
+            const int from_left = gallop_right(arr[j], temp + i, left_length - i);
+            memcpy(arr + k, temp + i, from_left * sizeof(int));
+            COUNT_SWAPS(from_left);
+            k += from_left;
+            i += from_left;
+            if (i == left_length) break;
+
+            const int from_right = gallop_left(temp[i], arr + j, end - j);
+            memmove(arr + k, arr + j, from_right * sizeof(int));
+            COUNT_SWAPS(from_right);
+            k += from_right;
+            j += from_right;
+
+            if (from_left < MIN_GALLOP && from_right < MIN_GALLOP) break;
+        }
+    }
+
+    // Le reste de la droite est déjà en place
+    memcpy(arr + k, temp + i, (left_length - i) * sizeof(int));
+    COUNT_SWAPS(left_length - i);
+}
+
+// Puissance du nœud entre les séquences [s1, s1+n1) et [s1+n1, s1+n1+n2):
+// premier bit où les milieux des deux séquences, rapportés à n, diffèrent.
+static int node_power(const long long s1, const long long n1, const long long n2, const long long n) {
+    long long a = 2 * s1 + n1;
+    long long b = a + n1 + n2;
+    int power = 0;
+
+    for (;;) {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+// Prochaine séquence à partir de start, étendue à min_run par insertion binaire
+static int next_run(int arr[], const int start, const int n, const int min_run) {
+    int length = count_run(arr, start, n);
+
+    if (length < min_run) {
+        const int forced = n - start < min_run ? n - start : min_run;
+        binary_insertion_sort(arr, start, start + forced, start + length);
+        length = forced;
+    }
+    return length;
+}
+
+// Tri adaptatif (Powersort): O(n) sur les listes triées ou inversées
+void adaptive_sort(int arr[], const int n) {
+    adaptive_sort_ws(arr, n, thread_workspace());
+}
+
+// Tri adaptatif, tampon de fusion pris dans l'espace de travail ws
+void adaptive_sort_ws(int arr[], const int n, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    const int min_run = compute_min_run(n);
+    int* temp = workspace_reserve(ws, n);
+    Run stack[MAX_RUN_STACK];
+    int top = 0;
+
+    Run current = {0, next_run(arr, 0, n, min_run), 0};
+
+    while (current.start + current.length < n) {
+        const int next_start = current.start + current.length;
+        const Run next = {next_start, next_run(arr, next_start, n, min_run), 0};
+        const int power = node_power(current.start, current.length, next.length, n);
+
+        // On fusionne tant que la pile contient des nœuds plus profonds
+        while (top > 0 && stack[top - 1].power > power) {
+            const Run left = stack[--top];
+            merge_runs(arr, left.start, current.start, current.start + current.length, temp);
+            current.start = left.start;
+            current.length += left.length;
+        }
+
+        current.power = power;
+        stack[top++] = current;
+        current = next;
+    }
+
+    // Fusion des séquences restantes, de droite à gauche
+    while (top > 0) {
+        const Run left = stack[--top];
+        merge_runs(arr, left.start, current.start, current.start + current.length, temp);
+        current.start = left.start;
+        current.length += left.length;
+    }
+}
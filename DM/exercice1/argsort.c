@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "tri_composite.h"
+
+// En dessous, les paires sont triées par insertion (4 histogrammes de 256
+// seaux ne valent pas la peine)
+#define ARGSORT_INSERTION_CUTOFF 64
+#define ARGSORT_BITS 8
+#define ARGSORT_BUCKETS (1 << ARGSORT_BITS)
+#define ARGSORT_PASSES (32 / ARGSORT_BITS)
+
+// Distance de préchargement de la lecture aléatoire de apply_permutation
+#define PERMUTE_PREFETCH 16
+
+// Paire (clé, indice) dans un entier 64 bits: la clé (bit de signe inversé)
+// en poids fort, l'indice en poids faible. Comparer les paires revient à
+// comparer les clés puis les indices: l'ordre est stable.
+static inline uint64_t pack_key_index(const int key, const int index) {
+    return (uint64_t)((unsigned int)key ^ 0x80000000u) << 32 | (unsigned int)index;
+}
+
+static inline int argsort_digit(const uint64_t entry, const int pass) {
+    return (entry >> (32 + pass * ARGSORT_BITS)) & (ARGSORT_BUCKETS - 1);
+}
+
+static void argsort_small(const int keys[], const int n, int perm[]) {
+    uint64_t entries[ARGSORT_INSERTION_CUTOFF];
+
+    for (int i = 0; i < n; i++) {
+        const uint64_t entry = pack_key_index(keys[i], i);
+        int j = i - 1;
+        while (j >= 0 && COUNT_COMPARISON(entries[j] > entry)) {
+            entries[j + 1] = entries[j];
+            COUNT_SWAP();
+            j--;
+        }
+        entries[j + 1] = entry;
+    }
+
+    for (int i = 0; i < n; i++) {
+        perm[i] = (int)(uint32_t)entries[i];
+    }
+}
+
+// Permutation stable qui trie keys
+void argsort(const int keys[], const int n, int perm[]) {
+    argsort_ws(keys, n, perm, thread_workspace());
+}
+
+// Tri par base LSD des paires (clé, indice). Les paires partent dans l'ordre
+// des indices, et chaque passage est stable: à clé égale, l'ordre des
+// indices est conservé. Les passages ne lisent que les paires (lecture
+// séquentielle, clé et indice côte à côte), jamais keys au hasard. Le
+// premier passage construit les paires à partir de keys, le dernier n'écrit
+// que les indices, directement dans perm; les passages dont tous les
+// chiffres sont égaux sont sautés.
+void argsort_ws(const int keys[], const int n, int perm[], SortWorkspace* ws) {
+    if (n <= 0) return;
+    if (n <= ARGSORT_INSERTION_CUTOFF) {
+        argsort_small(keys, n, perm);
+        return;
+    }
+
+    // Clés déjà dans l'ordre: l'identité (arrêt à la première descente)
+    int sorted = 1;
+    for (int i = 1; i < n && sorted; i++) {
+        sorted = COUNT_COMPARISON(keys[i - 1] <= keys[i]);
+    }
+    if (sorted) {
+        for (int i = 0; i < n; i++) perm[i] = i;
+        return;
+    }
+
+    int counts[ARGSORT_PASSES][ARGSORT_BUCKETS];
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < n; i++) {
+        const uint64_t entry = pack_key_index(keys[i], 0);
+        for (int p = 0; p < ARGSORT_PASSES; p++) {
+            counts[p][argsort_digit(entry, p)]++;
+        }
+    }
+
+    int passes[ARGSORT_PASSES];
+    int num_passes = 0;
+    const uint64_t first = pack_key_index(keys[0], 0);
+    for (int p = 0; p < ARGSORT_PASSES; p++) {
+        if (counts[p][argsort_digit(first, p)] != n) passes[num_passes++] = p;
+    }
+
+    uint64_t* buffer = workspace_reserve_bytes(ws, 2 * (size_t)n * sizeof(uint64_t));
+    uint64_t* src = buffer;
+    uint64_t* dst = buffer + n;
+
+    for (int q = 0; q < num_passes; q++) {
+        const int p = passes[q];
+        int* count = counts[p];
+        int offset = 0;
+        for (int b = 0; b < ARGSORT_BUCKETS; b++) {
+            const int c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+
+        const int last = q == num_passes - 1;
+        for (int i = 0; i < n; i++) {
+            const uint64_t entry = q == 0 ? pack_key_index(keys[i], i) : src[i];
+            const int position = count[argsort_digit(entry, p)]++;
+            if (last) {
+                perm[position] = (int)(uint32_t)entry;
+            } else {
+                dst[position] = entry;
+            }
+        }
+        COUNT_SWAPS(n);
+
+        uint64_t* swap_buffers = src;
+        src = dst;
+        dst = swap_buffers;
+    }
+}
+
+// Lecture aléatoire column[perm[i]] vers out[i], avec préchargement des
+// lectures PERMUTE_PREFETCH indices plus loin: plusieurs défauts de cache
+// sont en vol à la fois. Les tailles 4 et 8 ont leur boucle (copie d'un mot).
+#define GATHER_LOOP(type) do { \
+        const type* from = column; \
+        type* to = out; \
+        int i = 0; \
+        for (; i + PERMUTE_PREFETCH < n; i++) { \
+            __builtin_prefetch(&from[perm[i + PERMUTE_PREFETCH]]); \
+            to[i] = from[perm[i]]; \
+        } \
+        for (; i < n; i++) to[i] = from[perm[i]]; \
+    } while (0)
+
+static void gather(const int perm[], const int n, const void* column, const size_t element_size, void* out) {
+    if (element_size == sizeof(uint32_t)) {
+        GATHER_LOOP(uint32_t);
+    } else if (element_size == sizeof(uint64_t)) {
+        GATHER_LOOP(uint64_t);
+    } else {
+        const char* from = column;
+        char* to = out;
+        for (int i = 0; i < n; i++) {
+            if (i + PERMUTE_PREFETCH < n) __builtin_prefetch(from + perm[i + PERMUTE_PREFETCH] * element_size);
+            memcpy(to + i * element_size, from + perm[i] * element_size, element_size);
+        }
+    }
+}
+
+// columns[c][i] reçoit l'ancien columns[c][perm[i]], pour chaque colonne
+// (element_sizes[c] octets par élément): l'ordre de tri de argsort appliqué
+// à toutes les colonnes qui suivent la clé
+void apply_permutation(const int perm[], const int n, void* columns[], const size_t element_sizes[],
+                       const int num_columns) {
+    apply_permutation_ws(perm, n, columns, element_sizes, num_columns, thread_workspace());
+}
+
+// Une colonne à la fois: lecture dans l'ordre de perm vers le tampon,
+// préchargée, puis recopie séquentielle. Le tampon ne contient qu'une colonne.
+void apply_permutation_ws(const int perm[], const int n, void* columns[], const size_t element_sizes[],
+                          const int num_columns, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    size_t largest = 0;
+    for (int c = 0; c < num_columns; c++) {
+        if (element_sizes[c] > largest) largest = element_sizes[c];
+    }
+    void* out = workspace_reserve_bytes(ws, largest * n);
+
+    for (int c = 0; c < num_columns; c++) {
+        gather(perm, n, columns[c], element_sizes[c], out);
+        memcpy(columns[c], out, element_sizes[c] * n);
+        COUNT_SWAPS(2 * n);
+    }
+}
+
+// Copie d'un élément; les tailles 4 et 8 deviennent un seul mot copié
+static inline void copy_element(void* to, const void* from, const size_t element_size) {
+    if (element_size == sizeof(uint32_t)) {
+        memcpy(to, from, sizeof(uint32_t));
+    } else if (element_size == sizeof(uint64_t)) {
+        memcpy(to, from, sizeof(uint64_t));
+    } else {
+        memcpy(to, from, element_size);
+    }
+}
+
+// Même résultat, en place: on suit chaque cycle de perm une seule fois et
+// toutes les colonnes avancent ensemble (perm et les marques ne sont lus
+// qu'une fois). Mémoire: un octet par élément et un élément par colonne,
+// au lieu d'une colonne entière. Sur une permutation aléatoire, c'est une
+// chaîne de lectures dépendantes (perm[j], puis la colonne en perm[j]),
+// donc plus lent que apply_permutation: à réserver aux colonnes trop
+// grosses pour une copie.
+void apply_permutation_cycles(const int perm[], const int n, void* columns[], const size_t element_sizes[],
+                              const int num_columns) {
+    apply_permutation_cycles_ws(perm, n, columns, element_sizes, num_columns, thread_workspace());
+}
+
+// Marques et élément de tête de chaque colonne pris dans ws
+void apply_permutation_cycles_ws(const int perm[], const int n, void* columns[], const size_t element_sizes[],
+                                 const int num_columns, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    size_t row = 0;
+    for (int c = 0; c < num_columns; c++) row += element_sizes[c];
+
+    unsigned char* done = workspace_reserve_bytes(ws, n + row);
+    unsigned char* saved = done + n;
+    memset(done, 0, n);
+
+    for (int start = 0; start < n; start++) {
+        if (done[start] || perm[start] == start) continue;
+
+        // L'élément de tête est mis de côté; chaque position du cycle reçoit
+        // ensuite celui qu'elle désigne, et la dernière reçoit la tête
+        size_t at = 0;
+        for (int c = 0; c < num_columns; c++) {
+            copy_element(saved + at, (char*)columns[c] + start * element_sizes[c], element_sizes[c]);
+            at += element_sizes[c];
+        }
+
+        int j = start;
+        while (perm[j] != start) {
+            const int k = perm[j];
+            for (int c = 0; c < num_columns; c++) {
+                char* column = columns[c];
+                copy_element(column + j * element_sizes[c], column + k * element_sizes[c], element_sizes[c]);
+            }
+            COUNT_SWAPS(num_columns);
+            done[j] = 1;
+            j = k;
+        }
+
+        at = 0;
+        for (int c = 0; c < num_columns; c++) {
+            copy_element((char*)columns[c] + j * element_sizes[c], saved + at, element_sizes[c]);
+            at += element_sizes[c];
+        }
+        COUNT_SWAPS(num_columns);
+        done[j] = 1;
+    }
+}
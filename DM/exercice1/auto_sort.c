@@ -0,0 +1,398 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "tri_composite.h"
+#include "thread_pool.h"
+#include "benchmark.h"
+#include "generator.h"
+
+// Échantillonnage du profil: fenêtres contiguës pour les séquences, paires
+// pseudo-aléatoires pour les inversions, valeurs espacées pour les doublons.
+// Environ 2000 comparaisons en tout, quelle que soit la taille.
+#define AUTO_WINDOWS 32
+#define AUTO_WINDOW 32
+#define AUTO_PAIRS 512
+#define AUTO_VALUES 128
+
+// Fichier de calibration si SORT_AUTO_CALIBRATION n'est pas défini
+#define AUTO_DEFAULT_PATH "sort_auto.cal"
+
+// Noyau retenu par sort_auto
+typedef struct {
+    const char* name;
+    void (*sort)(int[], int);
+} AutoKernel;
+
+#ifndef SORT_UNCOUNTED
+// Seuils par défaut, avant toute calibration: ceux mesurés sur une machine
+// de développement (un cœur, AVX2)
+static SortAutoThresholds auto_thresholds = {
+    .insertion_max = 8,
+    .runs_max = 0.02,
+    .inversions_max = 1.0,
+    .nearly_sorted_max = 0.1,
+    .duplicates_min = 0.99,
+    .radix_min = 4096,
+    .parallel_min = 1 << 18
+};
+static pthread_once_t auto_thresholds_once = PTHREAD_ONCE_INIT;
+
+const char* sort_auto_calibration_path(void) {
+    const char* path = getenv("SORT_AUTO_CALIBRATION");
+    return path != NULL && path[0] != '\0' ? path : AUTO_DEFAULT_PATH;
+}
+
+int sort_auto_save(const char* path, const SortAutoThresholds* thresholds) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) return -1;
+
+    fprintf(out, "# Seuils de sort_auto calibrés sur cet hôte (sort_auto_calibrate)\n");
+    fprintf(out, "insertion_max %d\n", thresholds->insertion_max);
+    fprintf(out, "runs_max %.6f\n", thresholds->runs_max);
+    fprintf(out, "inversions_max %.6f\n", thresholds->inversions_max);
+    fprintf(out, "nearly_sorted_max %.6f\n", thresholds->nearly_sorted_max);
+    fprintf(out, "duplicates_min %.6f\n", thresholds->duplicates_min);
+    fprintf(out, "radix_min %d\n", thresholds->radix_min);
+    fprintf(out, "parallel_min %d\n", thresholds->parallel_min);
+
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+// Les clés absentes gardent leur valeur; une clé inconnue est une erreur
+int sort_auto_load(const char* path, SortAutoThresholds* thresholds) {
+    FILE* in = fopen(path, "r");
+    if (in == NULL) return -1;
+
+    SortAutoThresholds loaded = *thresholds;
+    char line[256];
+    int ok = 1;
+
+    while (ok && fgets(line, sizeof(line), in) != NULL) {
+        char key[64];
+        double value;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "%63s %lf", key, &value) != 2) {
+            ok = 0;
+        } else if (strcmp(key, "insertion_max") == 0) {
+            loaded.insertion_max = value;
+        } else if (strcmp(key, "runs_max") == 0) {
+            loaded.runs_max = value;
+        } else if (strcmp(key, "inversions_max") == 0) {
+            loaded.inversions_max = value;
+        } else if (strcmp(key, "nearly_sorted_max") == 0) {
+            loaded.nearly_sorted_max = value;
+        } else if (strcmp(key, "duplicates_min") == 0) {
+            loaded.duplicates_min = value;
+        } else if (strcmp(key, "radix_min") == 0) {
+            loaded.radix_min = value;
+        } else if (strcmp(key, "parallel_min") == 0) {
+            loaded.parallel_min = value;
+        } else {
+            ok = 0;
+        }
+    }
+    fclose(in);
+
+    if (!ok) return -1;
+    *thresholds = loaded;
+    return 0;
+}
+
+// Au premier appel: seuils du fichier de calibration s'il existe
+static void load_calibration(void) {
+    sort_auto_load(sort_auto_calibration_path(), &auto_thresholds);
+}
+
+void sort_auto_get_thresholds(SortAutoThresholds* thresholds) {
+    pthread_once(&auto_thresholds_once, load_calibration);
+    *thresholds = auto_thresholds;
+}
+
+void sort_auto_set_thresholds(const SortAutoThresholds* thresholds) {
+    pthread_once(&auto_thresholds_once, load_calibration);
+    auto_thresholds = *thresholds;
+}
+#endif
+
+// Nombre de fins de séquence (croissante au sens large, ou strictement
+// décroissante, comme adaptive_sort) dans arr[start..start+length)
+static int run_breaks(const int arr[], const int start, const int length) {
+    int breaks = 0;
+    int direction = 0;
+
+    for (int i = start + 1; i < start + length; i++) {
+        const int descending = COUNT_COMPARISON(arr[i] < arr[i - 1]);
+        if (direction == 0) {
+            direction = descending ? -1 : 1;
+        } else if ((direction > 0) == descending) {
+            breaks++;
+            direction = 0;
+        }
+    }
+    return breaks;
+}
+
+void sort_auto_profile(const int arr[], const int n, SortAutoProfile* profile) {
+    profile->n = n;
+    profile->run_ratio = 0;
+    profile->inversion_ratio = 0;
+    profile->duplicate_ratio = 0;
+    if (n < 2) return;
+
+    // Séquences: fenêtres régulièrement espacées (toute la liste si elle est petite)
+    int breaks = 0;
+    long pairs = 0;
+    if (n <= AUTO_WINDOWS * AUTO_WINDOW) {
+        breaks = run_breaks(arr, 0, n);
+        pairs = n - 1;
+    } else {
+        for (int w = 0; w < AUTO_WINDOWS; w++) {
+            const int start = (long)w * (n - AUTO_WINDOW) / (AUTO_WINDOWS - 1);
+            breaks += run_breaks(arr, start, AUTO_WINDOW);
+            pairs += AUTO_WINDOW - 1;
+        }
+    }
+    profile->run_ratio = (double)breaks / pairs;
+
+    // Inversions: paires (i < j) tirées par un générateur fixe, pour qu'une
+    // même liste donne toujours le même choix
+    Rng rng;
+    rng_seed(&rng, n);
+    int inversions = 0;
+    for (int p = 0; p < AUTO_PAIRS; p++) {
+        int i = rng_bounded(&rng, n);
+        int j = rng_bounded(&rng, n);
+        if (i > j) {
+            const int temp = i;
+            i = j;
+            j = temp;
+        }
+        inversions += COUNT_COMPARISON(arr[i] > arr[j]);
+    }
+    profile->inversion_ratio = (double)inversions / AUTO_PAIRS;
+
+    // Doublons: valeurs espacées, triées, égalités entre voisines
+    const int m = n < AUTO_VALUES ? n : AUTO_VALUES;
+    int sample[AUTO_VALUES];
+    for (int s = 0; s < m; s++) {
+        sample[s] = arr[(long)s * n / m];
+    }
+    insertion_sort_iterative(sample, m);
+    int equal = 0;
+    for (int s = 1; s < m; s++) {
+        equal += COUNT_COMPARISON(sample[s] == sample[s - 1]);
+    }
+    profile->duplicate_ratio = (double)equal / (m - 1);
+}
+
+// Noyau pour une taille sans particularité de profil
+static AutoKernel general_kernel(const int n, const SortAutoThresholds* t) {
+    if (n <= t->insertion_max) return (AutoKernel){"insertion_sort_iterative", insertion_sort_iterative};
+    if (n >= t->parallel_min && thread_pool_size() > 1) {
+        return (AutoKernel){"parallel_sample_sort", parallel_sample_sort};
+    }
+    if (n >= t->radix_min) return (AutoKernel){"radix_sort_lsd", radix_sort_lsd};
+    return (AutoKernel){"quick_sort_block", quick_sort_block};
+}
+
+// Inversions par élément, borne haute: l'estimation plus un pas
+// d'échantillonnage (1 / AUTO_PAIRS). Une liste qui paraît sans inversion
+// en a peut-être n / (2 AUTO_PAIRS) par élément: la borne ne devient petite
+// que sur les petites listes, seules où l'estimation est assez fine pour
+// confier la liste au tri par insertion.
+static double inversions_bound(const SortAutoProfile* profile) {
+    return (profile->inversion_ratio + 1.0 / AUTO_PAIRS) * (profile->n - 1) / 2;
+}
+
+static AutoKernel choose_kernel(const SortAutoProfile* profile, const SortAutoThresholds* t) {
+    if (profile->n <= t->insertion_max) return general_kernel(profile->n, t);
+
+    // Peu de séquences (triée, inversée, en dents de scie, en orgue):
+    // adaptive_sort les fusionne, son coût suit leur nombre
+    if (profile->run_ratio <= t->runs_max) return (AutoKernel){"adaptive_sort", adaptive_sort};
+
+    // Peu d'inversions (éléments proches de leur place): le tri par
+    // insertion coûte n + inversions
+    if (inversions_bound(profile) <= t->inversions_max) {
+        return (AutoKernel){"insertion_sort_iterative", insertion_sort_iterative};
+    }
+    if (profile->duplicate_ratio >= t->duplicates_min) {
+        return (AutoKernel){"quick_sort_3way", quick_sort_3way};
+    }
+
+    // Presque triée (ou presque inversée) mais en séquences trop courtes:
+    // les partitions de quick_sort_block déplacent peu d'éléments, le tri
+    // par base paie ses passes complètes
+    const AutoKernel general = general_kernel(profile->n, t);
+    if (general.sort == radix_sort_lsd && (profile->inversion_ratio <= t->nearly_sorted_max ||
+                                           profile->inversion_ratio >= 1 - t->nearly_sorted_max)) {
+        return (AutoKernel){"quick_sort_block", quick_sort_block};
+    }
+    return general;
+}
+
+const char* sort_auto_choice(const SortAutoProfile* profile) {
+    SortAutoThresholds thresholds;
+    sort_auto_get_thresholds(&thresholds);
+    return choose_kernel(profile, &thresholds).name;
+}
+
+// Tri automatique: profil échantillonné, puis le noyau que la calibration
+// désigne pour ce profil
+void sort_auto(int arr[], const int n) {
+    if (n < 2) return;
+
+    SortAutoThresholds thresholds;
+    sort_auto_get_thresholds(&thresholds);
+
+    SortAutoProfile profile = {n, 1, 0.5, 0};
+    if (n > thresholds.insertion_max) sort_auto_profile(arr, n, &profile);
+    choose_kernel(&profile, &thresholds).sort(arr, n);
+}
+
+#ifdef SORT_UNCOUNTED
+// Calibration: seulement dans la copie sans compteurs, pour mesurer les
+// noyaux sans instrumentation
+
+#define CALIBRATION_REPEATS 3
+#define CALIBRATION_SIZE (1 << 18)
+#define CALIBRATION_MAX_SIZE (1 << 22)
+// Éléments triés par mesure sur de petits blocs (insertion_max, inversions_max)
+#define CALIBRATION_SMALL_TOTAL (1 << 16)
+#define CALIBRATION_INVERSION_BLOCK 512
+
+// Meilleur temps pour trier source[0..n) par blocs de block éléments
+static double calibration_time(const int source[], int work[], const int n, const int block,
+                               void (*sort)(int[], int)) {
+    double best = -1;
+    for (int r = 0; r < CALIBRATION_REPEATS; r++) {
+        memcpy(work, source, n * sizeof(int));
+        const double start = bench_wall_time();
+        for (int b = 0; b + block <= n; b += block) {
+            sort(work + b, block);
+        }
+        const double t = bench_wall_time() - start;
+        if (best < 0 || t < best) best = t;
+    }
+    return best;
+}
+
+// Le noyau spécialisé bat-il le noyau général sur cette liste?
+static int specialist_wins(const int source[], int work[], const int n, void (*specialist)(int[], int),
+                           const SortAutoThresholds* t) {
+    const double general = calibration_time(source, work, n, n, general_kernel(n, t).sort);
+    return calibration_time(source, work, n, n, specialist) < general;
+}
+
+// Mesure les seuils sur cet hôte (quelques secondes). Chaque seuil compare le
+// noyau spécialisé au noyau général sur des entrées dont on fait varier une
+// seule caractéristique; les ratios retenus sont ceux que sort_auto_profile
+// mesure sur ces entrées, donc comparables à ceux de sort_auto.
+void sort_auto_calibrate(SortAutoThresholds* t) {
+    int* source = malloc(CALIBRATION_MAX_SIZE * sizeof(int));
+    int* work = malloc(CALIBRATION_MAX_SIZE * sizeof(int));
+    Rng rng;
+    rng_seed(&rng, generator_default_seed());
+    generate_pattern(source, CALIBRATION_MAX_SIZE, GEN_RANDOM, rng_next(&rng));
+
+    // 1. Tri par insertion contre quick_sort_block sur de petits blocs
+    t->insertion_max = 0;
+    for (int block = 4; block <= 128; block += 4) {
+        const double insertion = calibration_time(source, work, CALIBRATION_SMALL_TOTAL, block,
+                                                  insertion_sort_iterative);
+        if (insertion > calibration_time(source, work, CALIBRATION_SMALL_TOTAL, block, quick_sort_block)) break;
+        t->insertion_max = block;
+    }
+
+    // 2. Tri par base contre quick_sort_block, puis tri parallèle contre le
+    // meilleur des deux, par tailles doublées
+    t->radix_min = INT_MAX;
+    t->parallel_min = INT_MAX;
+    for (int n = 256; n <= CALIBRATION_MAX_SIZE && t->radix_min == INT_MAX; n *= 2) {
+        if (calibration_time(source, work, n, n, radix_sort_lsd) <
+            calibration_time(source, work, n, n, quick_sort_block)) {
+            t->radix_min = n;
+        }
+    }
+    if (thread_pool_size() > 1) {
+        for (int n = 1 << 14; n <= CALIBRATION_MAX_SIZE && t->parallel_min == INT_MAX; n *= 2) {
+            const double serial = calibration_time(source, work, n, n, general_kernel(n, t).sort);
+            if (calibration_time(source, work, n, n, parallel_sample_sort) < serial) t->parallel_min = n;
+        }
+    }
+
+    const int n = CALIBRATION_SIZE;
+    SortAutoProfile profile;
+
+    // 3. Séquences: n / length séquences croissantes entrelacées (valeurs
+    // distinctes, sans autre particularité), de plus en plus courtes
+    t->runs_max = 0;
+    for (int length = n / 2; length >= 2; length /= 2) {
+        const int runs = n / length;
+        for (int i = 0; i < n; i++) {
+            source[i] = (i % length) * runs + i / length;
+        }
+        sort_auto_profile(source, n, &profile);
+        if (!specialist_wins(source, work, n, adaptive_sort, t)) break;
+        t->runs_max = profile.run_ratio;
+    }
+
+    // 4. Inversions: petits blocs triés où chaque élément est échangé avec
+    // un voisin à au plus distance positions, distance croissante. Le seuil
+    // est la borne d'inversions par élément du dernier bloc où l'insertion gagne.
+    t->inversions_max = 0;
+    const int block = CALIBRATION_INVERSION_BLOCK;
+    for (int distance = 1; distance < block; distance *= 2) {
+        for (int b = 0; b < CALIBRATION_SMALL_TOTAL; b += block) {
+            int* values = source + b;
+            for (int i = 0; i < block; i++) values[i] = i;
+            for (int i = 0; i + 1 < block; i++) {
+                const int reach = distance < block - 1 - i ? distance : block - 1 - i;
+                const int j = i + rng_bounded(&rng, reach + 1);
+                const int temp = values[i];
+                values[i] = values[j];
+                values[j] = temp;
+            }
+        }
+        sort_auto_profile(source, block, &profile);
+        const double insertion = calibration_time(source, work, CALIBRATION_SMALL_TOTAL, block,
+                                                  insertion_sort_iterative);
+        if (insertion >= calibration_time(source, work, CALIBRATION_SMALL_TOTAL, block,
+                                          general_kernel(block, t).sort)) {
+            break;
+        }
+        t->inversions_max = inversions_bound(&profile);
+    }
+
+    // 5. Presque triée: liste triée dont une fraction croissante des
+    // éléments est échangée au hasard, quick_sort_block contre le tri par base
+    t->nearly_sorted_max = 0;
+    for (int swaps = n / 4096; swaps <= n && general_kernel(n, t).sort == radix_sort_lsd; swaps *= 2) {
+        for (int i = 0; i < n; i++) source[i] = i;
+        for (int s = 0; s < swaps; s++) {
+            const int i = rng_bounded(&rng, n);
+            const int j = rng_bounded(&rng, n);
+            const int temp = source[i];
+            source[i] = source[j];
+            source[j] = temp;
+        }
+        sort_auto_profile(source, n, &profile);
+        if (!specialist_wins(source, work, n, quick_sort_block, t)) break;
+        t->nearly_sorted_max = profile.inversion_ratio;
+    }
+
+    // 6. Doublons: valeurs tirées parmi de plus en plus de valeurs distinctes
+    t->duplicates_min = 1.01;
+    for (int distinct = 2; distinct <= n; distinct *= 2) {
+        for (int i = 0; i < n; i++) source[i] = rng_bounded(&rng, distinct);
+        sort_auto_profile(source, n, &profile);
+        if (!specialist_wins(source, work, n, quick_sort_3way, t)) break;
+        t->duplicates_min = profile.duplicate_ratio;
+    }
+
+    free(source);
+    free(work);
+}
+#endif
@@ -0,0 +1,1496 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "tri_composite.h"
+#include "thread_pool.h"
+#include "typed_sort.h"
+#include "benchmark.h"
+#include "generator.h"
+
+#define BENCH_REPEATS 5
+#define BENCH_DEFAULT_SIZE 10000
+#define PARALLEL_BENCH_MIN_SIZE (1 << 22)
+#define PARALLEL_BENCH_MAX_THREADS 64
+// Éléments par thread du passage à l'échelle faible
+#define WEAK_SCALING_PER_THREAD (1 << 20)
+#define WORKSPACE_BENCH_BATCHES 200
+#define MERGE_BENCH_MIN_SIZE (1 << 20)
+#define TYPED_BENCH_MIN_SIZE (1 << 20)
+#define GENERATOR_BENCH_MIN_SIZE (1 << 22)
+#define SELECTION_BENCH_MIN_SIZE (1 << 22)
+#define AUTO_BENCH_MIN_SIZE (1 << 20)
+#define SEGMENTS_BENCH_MIN_SIZE (1 << 22)
+#define ARGSORT_BENCH_MIN_SIZE (1 << 22)
+// Blocs lus par la sélection en flux
+#define TOPK_STREAM_BLOCK 4096
+#define INCREMENTAL_BENCH_BATCH 1024
+
+// Au-delà, les tris quadratiques (ou à récursion de profondeur n) sont exclus du rapport
+#define QUADRATIC_MAX_SIZE 20000
+
+typedef struct {
+    char* name;
+    void (*counted)(int[], int);
+    void (*uncounted)(int[], int);
+} InstrumentedKernel;
+
+static char* bench_types[] = {"sorted", "nearly_sorted", "reverse", "random"};
+static const int bench_num_types = 4;
+
+// Le rapport ajoute des listes à peu de valeurs distinctes (données catégorielles)
+static char* report_types[] = {"sorted", "nearly_sorted", "reverse", "random", "few_unique"};
+static const int report_num_types = 5;
+
+// Meilleur temps sur BENCH_REPEATS exécutions (la source n'est jamais modifiée)
+static double best_time(int source[], int work[], const int size, void (*sort_function)(int[], int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array(source, work, size);
+        const double t = time_sort(work, size, sort_function);
+        if (best < 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Coût de l'instrumentation: version avec compteurs vs copie sans compteurs
+static void bench_instrumentation(const int size) {
+    const InstrumentedKernel kernels[] = {
+        {"Insértion (iter)", insertion_sort_iterative, insertion_sort_iterative_uncounted},
+        {"Insértion (rec)", insertion_sort_recursive, insertion_sort_recursive_uncounted},
+        {"Tri Fusion (rec)", merge_sort_recursive, merge_sort_recursive_uncounted},
+        {"Tri Fusion (iter)", merge_sort_iterative, merge_sort_iterative_uncounted},
+        {"Tri Fusion (ping-pong)", merge_sort_pingpong, merge_sort_pingpong_uncounted},
+        {"Tri Fusion (k voies)", merge_sort_kway, merge_sort_kway_uncounted},
+        {"Tri Rapide", quick_sort_classic, quick_sort_classic_uncounted},
+        {"Tri Rapide (médiane)", quick_sort_median, quick_sort_median_uncounted},
+        {"Tri Rapide (3 voies)", quick_sort_3way, quick_sort_3way_uncounted},
+        {"Tri Fusion (parallèle)", parallel_merge_sort, parallel_merge_sort_uncounted},
+        {"Tri par Échantillonnage", parallel_sample_sort, parallel_sample_sort_uncounted},
+        {"Tri Rapide (intro)", quick_sort_intro, quick_sort_intro_uncounted},
+        {"Tri par Tas", heap_sort, heap_sort_uncounted},
+        {"Tri Rapide (blocs)", quick_sort_block, quick_sort_block_uncounted},
+        {"Tri par Base (LSD)", radix_sort_lsd, radix_sort_lsd_uncounted},
+        {"Tri par Base (LSD 11)", radix_sort_lsd11, radix_sort_lsd11_uncounted},
+        {"Tri par Base (MSD)", radix_sort_msd, radix_sort_msd_uncounted},
+        {"Tri Adaptatif", adaptive_sort, adaptive_sort_uncounted},
+        {"Tri Automatique", sort_auto, sort_auto_uncounted}
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    printf("Surcoût de l'instrumentation (n = %d, meilleur de %d essais)\n", size, BENCH_REPEATS);
+
+    int* work = malloc(size * sizeof(int));
+
+    for (int t = 0; t < bench_num_types; t++) {
+        int* source = create_array(size, bench_types[t]);
+
+        printf("\nType de données: %s\n", bench_types[t]);
+        printf("----------------------------------------------------------------\n");
+        printf("%-22s %13s %13s %12s\n", "Algorithme", "Compteurs (s)", "Sans (s)", "Surcoût");
+        printf("----------------------------------------------------------------\n");
+
+        for (int k = 0; k < num_kernels; k++) {
+            const double counted = best_time(source, work, size, kernels[k].counted);
+            const double uncounted = best_time(source, work, size, kernels[k].uncounted);
+
+            if (uncounted > 0) {
+                printf("%-22s %13.6f %13.6f %11.1f%%\n", kernels[k].name, counted, uncounted,
+                       100.0 * (counted - uncounted) / uncounted);
+            } else {
+                printf("%-22s %13.6f %13.6f %12s\n", kernels[k].name, counted, uncounted, "n/a");
+            }
+        }
+
+        free(source);
+    }
+
+    free(work);
+}
+
+// Meilleur temps réel sur BENCH_REPEATS exécutions; vérifie aussi le résultat
+static double best_wall_time(int source[], int work[], const int size, void (*sort_function)(int[], int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array(source, work, size);
+        const double t = wall_time_sort(work, size, sort_function);
+        if (!is_sorted(work, size)) {
+            fprintf(stderr, "Erreur: résultat non trié\n");
+            exit(1);
+        }
+        if (best < 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Liste des nombres de threads testés: 1, 2, 4, ... puis le maximum, qui est
+// le nombre de cœurs ou BENCH_MAX_THREADS (au plus PARALLEL_BENCH_MAX_THREADS)
+static int thread_counts(int counts[], const int max_counts) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* max_threads = getenv("BENCH_MAX_THREADS");
+    if (max_threads != NULL && *max_threads != '\0') cores = atoi(max_threads);
+    if (cores > PARALLEL_BENCH_MAX_THREADS) cores = PARALLEL_BENCH_MAX_THREADS;
+    if (cores < 1) cores = 1;
+
+    int num = 0;
+    for (int t = 1; t < cores && num < max_counts - 1; t *= 2) {
+        counts[num++] = t;
+    }
+    counts[num++] = (int)cores;
+    return num;
+}
+
+// Courbe d'accélération des tris parallèles jusqu'à tous les cœurs
+static void bench_parallel(int size) {
+    if (size < PARALLEL_BENCH_MIN_SIZE) size = PARALLEL_BENCH_MIN_SIZE;
+
+    const InstrumentedKernel kernels[] = {
+        {"Tri Fusion (parallèle)", parallel_merge_sort, parallel_merge_sort_uncounted},
+        {"Tri Rapide (introspectif)", quick_sort_intro, quick_sort_intro_uncounted},
+        {"Tri par Échantillonnage", parallel_sample_sort, parallel_sample_sort_uncounted}
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    int counts[32];
+    const int num_counts = thread_counts(counts, 32);
+
+    printf("Tris parallèles (n = %d, seuils série: fusion %d, rapide %d, meilleur de %d essais)\n",
+           size, parallel_merge_cutoff, parallel_quick_cutoff, BENCH_REPEATS);
+
+    int* work = malloc(size * sizeof(int));
+
+    for (int t = 0; t < bench_num_types; t++) {
+        int* source = create_array(size, bench_types[t]);
+
+        for (int k = 0; k < num_kernels; k++) {
+            printf("\n%s, type de données: %s\n", kernels[k].name, bench_types[t]);
+            printf("--------------------------------------------------\n");
+            printf("%8s %14s %12s %12s\n", "Threads", "Temps (s)", "Accél.", "Efficacité");
+            printf("--------------------------------------------------\n");
+
+            double reference = 0;
+            for (int c = 0; c < num_counts; c++) {
+                thread_pool_init(counts[c]);
+                const double t = best_wall_time(source, work, size, kernels[k].uncounted);
+                if (c == 0) reference = t;
+
+                const double speedup = t > 0 ? reference / t : 0;
+                printf("%8d %14.6f %11.2fx %11.1f%%\n", counts[c], t, speedup,
+                       100.0 * speedup / counts[c]);
+            }
+        }
+
+        free(source);
+    }
+    thread_pool_shutdown();
+
+    free(work);
+}
+
+// Passage à l'échelle des tris parallèles, contre le meilleur noyau série
+// (quick_sort_block). Fort: n fixe, le temps doit baisser en 1/threads.
+// Faible: WEAK_SCALING_PER_THREAD éléments par thread, le temps doit rester constant.
+static void bench_scaling(int size) {
+    if (size < PARALLEL_BENCH_MIN_SIZE) size = PARALLEL_BENCH_MIN_SIZE;
+
+    const InstrumentedKernel kernels[] = {
+        {"Tri Fusion (parallèle)", parallel_merge_sort, parallel_merge_sort_uncounted},
+        {"Tri Rapide (introspectif)", quick_sort_intro, quick_sort_intro_uncounted},
+        {"Tri par Échantillonnage", parallel_sample_sort, parallel_sample_sort_uncounted}
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    int counts[32];
+    const int num_counts = thread_counts(counts, 32);
+    const int max_threads = counts[num_counts - 1];
+    const int weak_max = WEAK_SCALING_PER_THREAD * max_threads;
+    const int buffer_size = size > weak_max ? size : weak_max;
+
+    int* source = create_array(buffer_size, "random");
+    int* work = malloc(buffer_size * sizeof(int));
+
+    const double serial = best_wall_time(source, work, size, quick_sort_block_uncounted);
+    printf("Passage à l'échelle (aléatoire, meilleur de %d essais)\n", BENCH_REPEATS);
+    printf("Référence série quick_sort_block, n = %d: %.6f s\n", size, serial);
+
+    printf("\nÉchelle forte (n = %d), accélération par rapport à la référence série\n", size);
+    printf("--------------------------------------------------------------------------------------\n");
+    printf("%8s", "Threads");
+    for (int k = 0; k < num_kernels; k++) printf(" %25s", kernels[k].name);
+    printf("\n--------------------------------------------------------------------------------------\n");
+    for (int c = 0; c < num_counts; c++) {
+        thread_pool_init(counts[c]);
+        printf("%8d", counts[c]);
+        for (int k = 0; k < num_kernels; k++) {
+            const double t = best_wall_time(source, work, size, kernels[k].uncounted);
+            printf("      %9.6f s (%5.2fx)", t, serial / t);
+        }
+        printf("\n");
+    }
+
+    printf("\nÉchelle faible (%d éléments par thread), efficacité t(1) / t(p)\n", WEAK_SCALING_PER_THREAD);
+    printf("--------------------------------------------------------------------------------------\n");
+    printf("%8s", "Threads");
+    for (int k = 0; k < num_kernels; k++) printf(" %25s", kernels[k].name);
+    printf("\n--------------------------------------------------------------------------------------\n");
+    double reference[sizeof(kernels) / sizeof(kernels[0])];
+    for (int c = 0; c < num_counts; c++) {
+        const int n = WEAK_SCALING_PER_THREAD * counts[c];
+        thread_pool_init(counts[c]);
+        printf("%8d", counts[c]);
+        for (int k = 0; k < num_kernels; k++) {
+            const double t = best_wall_time(source, work, n, kernels[k].uncounted);
+            if (c == 0) reference[k] = t;
+            printf("      %9.6f s (%4.0f %%)", t, 100.0 * reference[k] / t);
+        }
+        printf("\n");
+    }
+    thread_pool_shutdown();
+
+    free(source);
+    free(work);
+}
+
+typedef struct {
+    char* name;
+    int (*partition)(int[], int, int);
+} PartitionKernel;
+
+// Meilleur temps réel d'une seule partition de tout le tableau; vérifie le résultat
+static double best_partition_time(int source[], int work[], const int size,
+                                  int (*partition)(int[], int, int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array(source, work, size);
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        const int p = partition(work, 0, size - 1);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        for (int i = 0; i < size; i++) {
+            if ((i < p && work[i] > work[p]) || (i > p && work[i] < work[p])) {
+                fprintf(stderr, "Erreur: partition invalide\n");
+                exit(1);
+            }
+        }
+
+        const double t = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (best < 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Partition sans branchement (blocs, AVX2) contre partition_classic et partition_median
+static void bench_partition(int size) {
+    if (size < PARALLEL_BENCH_MIN_SIZE) size = PARALLEL_BENCH_MIN_SIZE;
+
+    const PartitionKernel partitions[] = {
+        {"partition_classic", partition_classic_uncounted},
+        {"partition_median", partition_median_uncounted},
+        {"partition_block", partition_block_uncounted},
+        {"partition_avx2", partition_avx2_uncounted}
+    };
+    const int num_partitions = __builtin_cpu_supports("avx2") ? 4 : 3;
+
+    const InstrumentedKernel sorts[] = {
+        {"Tri Rapide", quick_sort_classic, quick_sort_classic_uncounted},
+        {"Tri Rapide (médiane)", quick_sort_median, quick_sort_median_uncounted},
+        {"Tri Rapide (3 voies)", quick_sort_3way, quick_sort_3way_uncounted},
+        {"Tri Rapide (blocs)", quick_sort_block, quick_sort_block_uncounted}
+    };
+    const int num_sorts = sizeof(sorts) / sizeof(sorts[0]);
+
+    printf("Moteur de partition (n = %d, partition_fast = %s, meilleur de %d essais)\n",
+           size, partition_fast_name(), BENCH_REPEATS);
+
+    int* work = malloc(size * sizeof(int));
+
+    for (int t = 0; t < bench_num_types; t++) {
+        int* source = create_array(size, bench_types[t]);
+
+        printf("\nType de données: %s\n", bench_types[t]);
+        printf("--------------------------------------------------\n");
+        printf("%-24s %14s %10s\n", "Une partition", "Temps (s)", "ns/élém.");
+        printf("--------------------------------------------------\n");
+        for (int k = 0; k < num_partitions; k++) {
+            const double time = best_partition_time(source, work, size, partitions[k].partition);
+            printf("%-24s %14.6f %10.3f\n", partitions[k].name, time, 1e9 * time / size);
+        }
+
+        // Le tri rapide classique est quadratique sur les listes triées ou inversées
+        const int quadratic = strcmp(bench_types[t], "sorted") == 0 || strcmp(bench_types[t], "reverse") == 0;
+
+        printf("%-24s %14s %10s\n", "Tri complet", "Temps (s)", "ns/élém.");
+        printf("--------------------------------------------------\n");
+        for (int k = quadratic ? 2 : 0; k < num_sorts; k++) {
+            const double time = best_wall_time(source, work, size, sorts[k].uncounted);
+            printf("%-24s %14.6f %10.3f\n", sorts[k].name, time, 1e9 * time / size);
+        }
+
+        free(source);
+    }
+
+    free(work);
+}
+
+// Meilleur temps réel pour trier tous les blocs de block_size éléments de source
+static double best_blocks_time(int source[], int work[], const int size, const int block_size,
+                               void (*sort_function)(int[], int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array(source, work, size);
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int b = 0; b + block_size <= size; b += block_size) {
+            sort_function(work + b, block_size);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        for (int b = 0; b + block_size <= size; b += block_size) {
+            if (!is_sorted(work + b, block_size)) {
+                fprintf(stderr, "Erreur: bloc non trié\n");
+                exit(1);
+            }
+        }
+
+        const double t = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (best < 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Réseaux de tri (AVX2, scalaire) contre le tri par insertion sur de petits blocs
+static void bench_network(int size) {
+    if (size < PARALLEL_BENCH_MIN_SIZE) size = PARALLEL_BENCH_MIN_SIZE;
+
+    const int block_sizes[] = {8, 16, 32};
+    const int num_block_sizes = sizeof(block_sizes) / sizeof(block_sizes[0]);
+
+    const InstrumentedKernel kernels[] = {
+        {"Réseau (AVX2)", sort_network_avx2, sort_network_avx2_uncounted},
+        {"Réseau (scalaire)", sort_network_scalar, sort_network_scalar_uncounted},
+        {"Insértion (iter)", insertion_sort_iterative, insertion_sort_iterative_uncounted}
+    };
+    const int first_kernel = __builtin_cpu_supports("avx2") ? 0 : 1;
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    printf("Réseaux de tri sur des blocs indépendants (%d éléments au total)\n", size);
+
+    int* source = create_array(size, "random");
+    int* work = malloc(size * sizeof(int));
+
+    for (int b = 0; b < num_block_sizes; b++) {
+        printf("\nTaille de bloc: %d\n", block_sizes[b]);
+        printf("--------------------------------------------------\n");
+        printf("%-22s %14s %12s\n", "Algorithme", "Temps (s)", "ns/bloc");
+        printf("--------------------------------------------------\n");
+
+        for (int k = first_kernel; k < num_kernels; k++) {
+            const double time = best_blocks_time(source, work, size, block_sizes[b], kernels[k].uncounted);
+            printf("%-22s %14.6f %12.2f\n", kernels[k].name, time,
+                   1e9 * time / (size / block_sizes[b]));
+        }
+    }
+
+    free(source);
+    free(work);
+}
+
+typedef struct {
+    char* name;
+    void (*sort)(int[], int, SortWorkspace*);
+} WorkspaceKernel;
+
+// Temps réel pour trier WORKSPACE_BENCH_BATCHES lots de size éléments. Avec
+// shared == NULL, chaque lot a son propre espace de travail (un malloc/free
+// par appel, comme avant l'arène); sinon tous les lots réutilisent shared.
+static double batches_time(int source[], int work[], const int size,
+                           void (*sort_function)(int[], int, SortWorkspace*), SortWorkspace* shared) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int b = 0; b < WORKSPACE_BENCH_BATCHES; b++) {
+        copy_array(source, work, size);
+        if (shared != NULL) {
+            sort_function(work, size, shared);
+        } else {
+            SortWorkspace fresh = SORT_WORKSPACE_INIT;
+            sort_function(work, size, &fresh);
+            workspace_release(&fresh);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// Lots successifs de taille moyenne: espace de travail neuf à chaque appel
+// contre espace réutilisé (aucune allocation en régime permanent)
+static void bench_workspace(const int size) {
+    const WorkspaceKernel kernels[] = {
+        {"Tri Fusion (rec)", merge_sort_recursive_ws_uncounted},
+        {"Tri Fusion (iter)", merge_sort_iterative_ws_uncounted},
+        {"Tri Fusion (ping-pong)", merge_sort_pingpong_ws_uncounted},
+        {"Tri Fusion (k voies)", merge_sort_kway_ws_uncounted},
+        {"Tri par Base (LSD)", radix_sort_lsd_ws_uncounted},
+        {"Tri par Base (LSD 11)", radix_sort_lsd11_ws_uncounted},
+        {"Tri Adaptatif", adaptive_sort_ws_uncounted},
+        {"Tri Fusion (parallèle)", parallel_merge_sort_ws_uncounted},
+        {"Tri par Échantillonnage", parallel_sample_sort_ws_uncounted}
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    printf("Espace de travail réutilisable (%d lots de %d éléments)\n", WORKSPACE_BENCH_BATCHES, size);
+
+    int* source = create_array(size, "random");
+    int* work = malloc(size * sizeof(int));
+
+    printf("\n---------------------------------------------------------------------------\n");
+    printf("%-22s %14s %14s %12s %6s\n", "Algorithme", "Neuf (µs/lot)", "Réutil. (µs/lot)", "Allocations", "Trié");
+    printf("---------------------------------------------------------------------------\n");
+
+    for (int k = 0; k < num_kernels; k++) {
+        const double fresh = batches_time(source, work, size, kernels[k].sort, NULL);
+
+        // Le premier appel dimensionne l'espace; on ne compte que les suivants
+        SortWorkspace ws = SORT_WORKSPACE_INIT;
+        copy_array(source, work, size);
+        kernels[k].sort(work, size, &ws);
+        const int warm_allocations = ws.allocations;
+        const double reused = batches_time(source, work, size, kernels[k].sort, &ws);
+
+        printf("%-22s %14.2f %14.2f %12d %6s\n", kernels[k].name,
+               1e6 * fresh / WORKSPACE_BENCH_BATCHES, 1e6 * reused / WORKSPACE_BENCH_BATCHES,
+               ws.allocations - warm_allocations, is_sorted(work, size) ? "oui" : "non");
+        workspace_release(&ws);
+    }
+
+    free(source);
+    free(work);
+}
+
+// Les listes de create_array sont des permutations de 0..n-1: le résultat
+// trié est exactement l'identité (vérifie l'ordre et la permutation)
+static int is_identity(const int arr[], const int size) {
+    for (int i = 0; i < size; i++) {
+        if (arr[i] != i) return 0;
+    }
+    return 1;
+}
+
+// Tris fusion en ping-pong et à k voies contre merge_sort_recursive
+// (référence) sur tous les types de create_array: résultat et débit
+static void bench_merge(int size) {
+    if (size < MERGE_BENCH_MIN_SIZE) size = MERGE_BENCH_MIN_SIZE;
+
+    const InstrumentedKernel kernels[] = {
+        {"Tri Fusion (rec)", merge_sort_recursive, merge_sort_recursive_uncounted},
+        {"Tri Fusion (iter)", merge_sort_iterative, merge_sort_iterative_uncounted},
+        {"Tri Fusion (ping-pong)", merge_sort_pingpong, merge_sort_pingpong_uncounted},
+        {"Tri Fusion (k voies)", merge_sort_kway, merge_sort_kway_uncounted}
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    printf("Tris fusion (n = %d, meilleur de %d essais)\n", size, BENCH_REPEATS);
+
+    int* work = malloc(size * sizeof(int));
+
+    for (int t = 0; t < bench_num_types; t++) {
+        int* source = create_array(size, bench_types[t]);
+
+        printf("\nType de données: %s\n", bench_types[t]);
+        printf("----------------------------------------------------------------\n");
+        printf("%-24s %12s %12s %12s\n", "Algorithme", "Temps (s)", "Mélém./s", "Accélér.");
+        printf("----------------------------------------------------------------\n");
+
+        double reference = 0;
+        for (int k = 0; k < num_kernels; k++) {
+            // Correction: les versions avec et sans compteurs doivent trier
+            copy_array(source, work, size);
+            kernels[k].counted(work, size);
+            if (!is_identity(work, size)) {
+                fprintf(stderr, "Erreur: %s ne trie pas la liste %s\n", kernels[k].name, bench_types[t]);
+                exit(1);
+            }
+
+            const double time = best_wall_time(source, work, size, kernels[k].uncounted);
+            if (!is_identity(work, size)) {
+                fprintf(stderr, "Erreur: %s ne trie pas la liste %s\n", kernels[k].name, bench_types[t]);
+                exit(1);
+            }
+            if (k == 0) reference = time;
+
+            printf("%-24s %12.6f %12.1f %11.2fx\n", kernels[k].name, time,
+                   size / time / 1e6, time > 0 ? reference / time : 0.0);
+        }
+
+        free(source);
+    }
+
+    // kway_merge seul: fusion de fragments triés séparément (comme ceux des
+    // workers d'ingestion)
+    const int shard_counts[] = {2, 16, 64, 1000};
+    int* source = create_array(size, "random");
+
+    printf("\nFusion de fragments triés (kway_merge)\n");
+    printf("----------------------------------------------------------------\n");
+    printf("%-24s %12s %12s\n", "Fragments", "Temps (s)", "Mélém./s");
+    printf("----------------------------------------------------------------\n");
+
+    for (int c = 0; c < (int)(sizeof(shard_counts) / sizeof(shard_counts[0])); c++) {
+        const int k = shard_counts[c];
+        const int* spans[k];
+        int lengths[k];
+        for (int s = 0; s < k; s++) {
+            const int begin = (long)size * s / k;
+            lengths[s] = (long)size * (s + 1) / k - begin;
+            spans[s] = source + begin;
+            sort_int32(source + begin, lengths[s]);
+        }
+
+        double best = -1;
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            const double start = bench_wall_time();
+            kway_merge_uncounted(spans, lengths, k, work);
+            const double t = bench_wall_time() - start;
+            if (best < 0 || t < best) best = t;
+        }
+        if (!is_identity(work, size)) {
+            fprintf(stderr, "Erreur: kway_merge ne fusionne pas %d fragments\n", k);
+            exit(1);
+        }
+        printf("%-24d %12.6f %12.1f\n", k, best, size / best / 1e6);
+
+        // Fragments défaits pour le nombre suivant
+        shuffle_array(source, size);
+    }
+
+    free(source);
+    free(work);
+}
+
+// Valeurs aléatoires des tris spécialisés (index: position dans le tableau)
+static Rng typed_rng;
+static int32_t random_int32(const int index) { (void)index; return (int32_t)rng_next(&typed_rng); }
+static int64_t random_int64(const int index) { (void)index; return (int64_t)rng_next(&typed_rng); }
+static uint32_t random_uint32(const int index) { (void)index; return (uint32_t)rng_next(&typed_rng); }
+static float random_float(const int index) { (void)index; return (float)rng_double(&typed_rng) - 0.5f; }
+static double random_double(const int index) { (void)index; return rng_double(&typed_rng) - 0.5; }
+static KeyIndex random_key_index(const int index) { return (KeyIndex){rng_bounded(&typed_rng, 1000), index}; }
+
+#define SCALAR_LESS(a, b) ((a) < (b))
+#define KEY_LESS(a, b) ((a).key < (b).key)
+
+// Adaptateurs void* pour parcourir tous les types dans une même boucle:
+// remplissage, comparateur pour qsort (la référence) et noyaux spécialisés
+#define TYPED_BENCH_ADAPTERS(suffix, type, less) \
+    static void fill_##suffix(void* arr, const int n) { \
+        type* a = arr; \
+        for (int i = 0; i < n; i++) a[i] = random_##suffix(i); \
+    } \
+    static int compare_##suffix(const void* a, const void* b) { \
+        const type x = *(const type*)a; \
+        const type y = *(const type*)b; \
+        return less(y, x) - less(x, y); \
+    } \
+    static void any_sort_##suffix(void* arr, const int n) { sort_##suffix(arr, n); } \
+    static void any_stable_sort_##suffix(void* arr, const int n) { stable_sort_##suffix(arr, n); } \
+    static void any_radix_sort_##suffix(void* arr, const int n) { radix_sort_##suffix(arr, n); } \
+    static int any_is_sorted_##suffix(const void* arr, const int n) { return is_sorted_##suffix(arr, n); }
+
+TYPED_BENCH_ADAPTERS(int32, int32_t, SCALAR_LESS)
+TYPED_BENCH_ADAPTERS(int64, int64_t, SCALAR_LESS)
+TYPED_BENCH_ADAPTERS(uint32, uint32_t, SCALAR_LESS)
+TYPED_BENCH_ADAPTERS(float, float, SCALAR_LESS)
+TYPED_BENCH_ADAPTERS(double, double, SCALAR_LESS)
+TYPED_BENCH_ADAPTERS(key_index, KeyIndex, KEY_LESS)
+
+typedef struct {
+    char* name;
+    size_t element_size;
+    void (*fill)(void*, int);
+    int (*compare)(const void*, const void*);
+    void (*sorts[3])(void*, int);
+    int (*is_sorted)(const void*, int);
+} TypedBench;
+
+#define TYPED_BENCH_ENTRY(suffix, type) \
+    {#suffix, sizeof(type), fill_##suffix, compare_##suffix, \
+     {any_sort_##suffix, any_stable_sort_##suffix, any_radix_sort_##suffix}, any_is_sorted_##suffix}
+
+// Meilleur temps réel d'un tri spécialisé (sort_function) ou de qsort (compare)
+static double best_typed_time(const TypedBench* bench, const void* source, void* work, const int size,
+                              void (*sort_function)(void*, int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        memcpy(work, source, size * bench->element_size);
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (sort_function != NULL) {
+            sort_function(work, size);
+        } else {
+            qsort(work, size, bench->element_size, bench->compare);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (!bench->is_sorted(work, size)) {
+            fprintf(stderr, "Erreur: résultat non trié (%s)\n", bench->name);
+            exit(1);
+        }
+
+        const double t = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (best < 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Tris spécialisés par type contre qsort et son comparateur appelé par pointeur
+static void bench_typed(int size) {
+    if (size < TYPED_BENCH_MIN_SIZE) size = TYPED_BENCH_MIN_SIZE;
+    rng_seed(&typed_rng, generator_default_seed());
+
+    const TypedBench benches[] = {
+        TYPED_BENCH_ENTRY(int32, int32_t),
+        TYPED_BENCH_ENTRY(int64, int64_t),
+        TYPED_BENCH_ENTRY(uint32, uint32_t),
+        TYPED_BENCH_ENTRY(float, float),
+        TYPED_BENCH_ENTRY(double, double),
+        TYPED_BENCH_ENTRY(key_index, KeyIndex)
+    };
+    const int num_benches = sizeof(benches) / sizeof(benches[0]);
+
+    printf("Tris spécialisés par type (n = %d, meilleur de %d essais, temps en secondes)\n",
+           size, BENCH_REPEATS);
+    printf("\n--------------------------------------------------------------------------\n");
+    printf("%-12s %12s %12s %12s %12s %10s\n", "Type", "qsort", "sort", "stable_sort", "radix_sort",
+           "Accélér.");
+    printf("--------------------------------------------------------------------------\n");
+
+    for (int b = 0; b < num_benches; b++) {
+        void* source = malloc(size * benches[b].element_size);
+        void* work = malloc(size * benches[b].element_size);
+        benches[b].fill(source, size);
+
+        const double reference = best_typed_time(&benches[b], source, work, size, NULL);
+        double times[3];
+        double best = reference;
+        for (int k = 0; k < 3; k++) {
+            times[k] = best_typed_time(&benches[b], source, work, size, benches[b].sorts[k]);
+            if (times[k] < best) best = times[k];
+        }
+
+        // Accélération du meilleur noyau spécialisé par rapport à qsort
+        printf("%-12s %12.6f %12.6f %12.6f %12.6f %9.1fx\n", benches[b].name, reference,
+               times[0], times[1], times[2], best > 0 ? reference / best : 0.0);
+
+        free(source);
+        free(work);
+    }
+}
+
+typedef struct {
+    char* name;
+    void (*sort)(int[], int);
+    int max_size;
+    // Limite sur les listes à peu de valeurs distinctes, où les partitions à
+    // deux voies deviennent quadratiques (0: aucune)
+    int duplicates_max_size;
+} RegisteredSort;
+
+static int compare_ints(const void* a, const void* b) {
+    const int x = *(const int*)a;
+    const int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Référence de la bibliothèque standard (comparateur appelé par pointeur)
+static void qsort_ints(int arr[], const int n) {
+    qsort(arr, n, sizeof(int), compare_ints);
+}
+
+// Tous les tris d'entiers de l'exercice, sans compteurs. Les noms sont ceux
+// des fonctions: ils servent de clés pour comparer deux rapports.
+static const RegisteredSort registered_sorts[] = {
+    {"insertion_sort_iterative", insertion_sort_iterative_uncounted, QUADRATIC_MAX_SIZE, QUADRATIC_MAX_SIZE},
+    {"insertion_sort_recursive", insertion_sort_recursive_uncounted, QUADRATIC_MAX_SIZE, QUADRATIC_MAX_SIZE},
+    {"merge_sort_recursive", merge_sort_recursive_uncounted, 0, 0},
+    {"merge_sort_iterative", merge_sort_iterative_uncounted, 0, 0},
+    {"merge_sort_pingpong", merge_sort_pingpong_uncounted, 0, 0},
+    {"merge_sort_kway", merge_sort_kway_uncounted, 0, 0},
+    {"quick_sort_classic", quick_sort_classic_uncounted, QUADRATIC_MAX_SIZE, QUADRATIC_MAX_SIZE},
+    {"quick_sort_median", quick_sort_median_uncounted, 0, QUADRATIC_MAX_SIZE},
+    {"quick_sort_3way", quick_sort_3way_uncounted, 0, 0},
+    {"heap_sort", heap_sort_uncounted, 0, 0},
+    {"quick_sort_block", quick_sort_block_uncounted, 0, 0},
+    {"quick_sort_intro", quick_sort_intro_uncounted, 0, 0},
+    {"parallel_merge_sort", parallel_merge_sort_uncounted, 0, 0},
+    {"parallel_sample_sort", parallel_sample_sort_uncounted, 0, 0},
+    {"radix_sort_lsd", radix_sort_lsd_uncounted, 0, 0},
+    {"radix_sort_lsd11", radix_sort_lsd11_uncounted, 0, 0},
+    {"radix_sort_msd", radix_sort_msd_uncounted, 0, 0},
+    {"adaptive_sort", adaptive_sort_uncounted, 0, 0},
+    {"sort_auto", sort_auto_uncounted, 0, 0},
+    {"sort_int32", sort_int32, 0, 0},
+    {"stable_sort_int32", stable_sort_int32, 0, 0},
+    {"radix_sort_int32", radix_sort_int32, 0, 0},
+    {"qsort", qsort_ints, 0, 0}
+};
+static const int num_registered_sorts = sizeof(registered_sorts) / sizeof(registered_sorts[0]);
+
+typedef struct {
+    int* source;
+    int* work;
+    int size;
+    void (*sort)(int[], int);
+} ReportTrial;
+
+static void restore_report_input(void* arg) {
+    const ReportTrial* trial = arg;
+    copy_array(trial->source, trial->work, trial->size);
+}
+
+static void run_report_sort(void* arg) {
+    const ReportTrial* trial = arg;
+    trial->sort(trial->work, trial->size);
+}
+
+// Tous les algorithmes sur tous les types de liste, avec chauffe et essais
+// répétés; BENCH_OUTPUT=fichier.csv (ou .json) enregistre les résultats
+static void bench_report(const int size) {
+    BenchConfig config;
+    bench_config_from_env(&config);
+    BenchReport report;
+    bench_report_open(&report);
+
+    printf("Rapport (n = %d, %d chauffe(s), jusqu'à %d essais, budget %.1f s par mesure)\n",
+           size, config.warmup, config.trials, config.budget);
+
+    int* work = malloc(size * sizeof(int));
+
+    for (int t = 0; t < report_num_types; t++) {
+        int* source = create_array(size, report_types[t]);
+
+        printf("\nType de données: %s\n", report_types[t]);
+        printf("----------------------------------------------------------------------------------\n");
+        printf("%-26s %12s %12s %25s %7s\n", "Algorithme", "Médiane (s)", "p95 (s)", "IC 95 % médiane", "Essais");
+        printf("----------------------------------------------------------------------------------\n");
+
+        for (int a = 0; a < num_registered_sorts; a++) {
+            const RegisteredSort* algorithm = &registered_sorts[a];
+            if (algorithm->max_size > 0 && size > algorithm->max_size) continue;
+            if (strcmp(report_types[t], "few_unique") == 0 && algorithm->duplicates_max_size > 0 &&
+                size > algorithm->duplicates_max_size) continue;
+
+            ReportTrial trial = {source, work, size, algorithm->sort};
+            BenchResult result = {"exercice1", algorithm->name, report_types[t], size, 0, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+            bench_measure(&config, restore_report_input, run_report_sort, &trial, &result);
+
+            if (!is_sorted(work, size)) {
+                fprintf(stderr, "Erreur: %s ne trie pas la liste %s\n", algorithm->name, report_types[t]);
+                exit(1);
+            }
+
+            printf("%-26s %12.6f %12.6f      [%9.6f, %9.6f] %7d\n", algorithm->name, result.wall.median,
+                   result.wall.p95, result.wall.ci_low, result.wall.ci_high, result.trials);
+            bench_report_add(&report, &result);
+        }
+
+        free(source);
+    }
+
+    free(work);
+    bench_report_close(&report);
+}
+
+// Vérifie que arr[0..n) contient des valeurs distinctes de [min_val, max_val]
+static int all_distinct(const int arr[], const int n, const int min_val, const int max_val) {
+    int32_t* sorted = malloc(n * sizeof(int32_t));
+    memcpy(sorted, arr, n * sizeof(int32_t));
+    radix_sort_int32(sorted, n);
+
+    int ok = n == 0 || (sorted[0] >= min_val && sorted[n - 1] <= max_val);
+    for (int i = 1; i < n && ok; i++) {
+        ok = sorted[i - 1] < sorted[i];
+    }
+    free(sorted);
+    return ok;
+}
+
+// Débit du générateur pour chaque motif, et reproductibilité à graine égale
+static void bench_generator(int size) {
+    if (size < GENERATOR_BENCH_MIN_SIZE) size = GENERATOR_BENCH_MIN_SIZE;
+
+    const uint64_t seed = generator_default_seed();
+    int* first = malloc(size * sizeof(int));
+    int* second = malloc(size * sizeof(int));
+
+    printf("Générateur de listes (n = %d, %ld cœurs)\n", size, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("\n------------------------------------------------------------\n");
+    printf("%-16s %12s %14s %14s\n", "Motif", "Temps (s)", "M éléments/s", "Reproductible");
+    printf("------------------------------------------------------------\n");
+
+    for (int p = 0; p < GEN_NUM_PATTERNS; p++) {
+        double t = bench_wall_time();
+        generate_pattern(first, size, p, seed);
+        t = bench_wall_time() - t;
+        generate_pattern(second, size, p, seed);
+
+        const int same = memcmp(first, second, size * sizeof(int)) == 0;
+        printf("%-16s %12.6f %14.1f %14s\n", generator_pattern_name(p), t, size / t / 1e6,
+               same ? "oui" : "NON");
+        if (!same) {
+            fprintf(stderr, "Erreur: le motif %s dépend d'autre chose que la graine\n",
+                    generator_pattern_name(p));
+            exit(1);
+        }
+    }
+
+    // Valeurs distinctes: une plage tout juste assez grande est le pire cas
+    // d'un tirage avec rejet des doublons
+    const int ranges[] = {size, 4 * size, 1000000000};
+    printf("\nValeurs distinctes (generate_distinct)\n");
+    printf("------------------------------------------------------------\n");
+    printf("%-16s %12s %14s %14s\n", "Plage", "Temps (s)", "M éléments/s", "Distinctes");
+    printf("------------------------------------------------------------\n");
+
+    for (int r = 0; r < (int)(sizeof(ranges) / sizeof(ranges[0])); r++) {
+        if (ranges[r] < size) continue;
+
+        double t = bench_wall_time();
+        generate_distinct(first, size, 0, ranges[r] - 1, seed);
+        t = bench_wall_time() - t;
+
+        const int ok = all_distinct(first, size, 0, ranges[r] - 1);
+        printf("%-16d %12.6f %14.1f %14s\n", ranges[r], t, size / t / 1e6, ok ? "oui" : "NON");
+        if (!ok) {
+            fprintf(stderr, "Erreur: generate_distinct a produit un doublon\n");
+            exit(1);
+        }
+    }
+
+    free(first);
+    free(second);
+}
+
+// Vérifie la sélection de rang k dans work contre la liste triée sorted
+static int is_selected(const int work[], const int sorted[], const int n, const int k) {
+    if (work[k] != sorted[k]) return 0;
+    for (int i = 0; i < n; i++) {
+        if ((i < k && work[i] > work[k]) || (i > k && work[i] < work[k])) return 0;
+    }
+    return 1;
+}
+
+// Meilleur temps de sélection du rang k (nth_element) ou des k plus petits
+// (partial_sort) sur BENCH_REPEATS exécutions
+static double best_select_time(int source[], int work[], const int size, const int k,
+                               void (*select_function)(int[], int, int)) {
+    double best = -1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array(source, work, size);
+        const double start = bench_wall_time();
+        select_function(work, size, k);
+        const double t = bench_wall_time() - start;
+        if (best < 0 || t < best) best = t;
+    }
+    return best;
+}
+
+// nth_element, partial_sort, top-k en flux et tri incrémental contre un tri
+// complet (quick_sort_block): O(n) contre O(n log n)
+static void bench_selection(int size) {
+    if (size < SELECTION_BENCH_MIN_SIZE) size = SELECTION_BENCH_MIN_SIZE;
+
+    char* types[] = {"sorted", "reverse", "random", "duplicates", "few_unique", "organ_pipe"};
+    const int num_types = sizeof(types) / sizeof(types[0]);
+    const int ks[] = {10, size / 100};
+
+    printf("Sélection (n = %d, meilleur de %d essais)\n", size, BENCH_REPEATS);
+
+    int* work = malloc(size * sizeof(int));
+    int* sorted = malloc(size * sizeof(int));
+
+    for (int t = 0; t < num_types; t++) {
+        int* source = create_array(size, types[t]);
+        copy_array(source, sorted, size);
+        sort_int32(sorted, size);
+
+        printf("\nType de données: %s\n", types[t]);
+        printf("----------------------------------------------------------------\n");
+        printf("%-32s %12s %12s\n", "Opération", "Temps (s)", "Accélér.");
+        printf("----------------------------------------------------------------\n");
+
+        const double full = best_wall_time(source, work, size, quick_sort_block_uncounted);
+        printf("%-32s %12.6f %11.2fx\n", "Tri complet (quick_sort_block)", full, 1.0);
+
+        // Correction: versions avec et sans compteurs, rangs extrêmes et médian
+        const int ranks[] = {0, size / 2, size - 1};
+        for (int r = 0; r < 3; r++) {
+            copy_array(source, work, size);
+            nth_element(work, size, ranks[r]);
+            const int counted_ok = is_selected(work, sorted, size, ranks[r]);
+            copy_array(source, work, size);
+            nth_element_uncounted(work, size, ranks[r]);
+            if (!counted_ok || !is_selected(work, sorted, size, ranks[r])) {
+                fprintf(stderr, "Erreur: nth_element(%d) faux sur la liste %s\n", ranks[r], types[t]);
+                exit(1);
+            }
+        }
+        const double median = best_select_time(source, work, size, size / 2, nth_element_uncounted);
+        printf("%-32s %12.6f %11.2fx\n", "nth_element (médiane)", median, full / median);
+
+        for (int q = 0; q < 2; q++) {
+            const int k = ks[q];
+            copy_array(source, work, size);
+            partial_sort(work, size, k);
+            const int counted_ok = memcmp(work, sorted, k * sizeof(int)) == 0;
+            const double time = best_select_time(source, work, size, k, partial_sort_uncounted);
+            if (!counted_ok || memcmp(work, sorted, k * sizeof(int)) != 0) {
+                fprintf(stderr, "Erreur: partial_sort(%d) faux sur la liste %s\n", k, types[t]);
+                exit(1);
+            }
+
+            char label[64];
+            snprintf(label, sizeof(label), "partial_sort (k = %d)", k);
+            printf("%-32s %12.6f %11.2fx\n", label, time, full / time);
+        }
+
+        // Top-k en flux: la liste arrive par blocs, seuls 2k entiers sont gardés
+        for (int q = 0; q < 2; q++) {
+            const int k = ks[q];
+            double best = -1;
+            for (int r = 0; r < BENCH_REPEATS; r++) {
+                TopK topk;
+                const double start = bench_wall_time();
+                topk_init_uncounted(&topk, k);
+                for (int i = 0; i < size; i += TOPK_STREAM_BLOCK) {
+                    topk_push_uncounted(&topk, source + i, size - i < TOPK_STREAM_BLOCK ? size - i : TOPK_STREAM_BLOCK);
+                }
+                const int found = topk_result_uncounted(&topk, work);
+                const double time = bench_wall_time() - start;
+                topk_free_uncounted(&topk);
+
+                if (found != k || memcmp(work, sorted, k * sizeof(int)) != 0) {
+                    fprintf(stderr, "Erreur: top-%d en flux faux sur la liste %s\n", k, types[t]);
+                    exit(1);
+                }
+                if (best < 0 || time < best) best = time;
+            }
+
+            char label[64];
+            snprintf(label, sizeof(label), "top-k en flux (k = %d)", k);
+            printf("%-32s %12.6f %11.2fx\n", label, best, full / best);
+        }
+
+        // Tri incrémental: les k premiers lus par lots, puis la liste entière
+        const int consumed[] = {ks[0], ks[1], size};
+        for (int q = 0; q < 3; q++) {
+            const int k = consumed[q];
+            int* batch = malloc(INCREMENTAL_BENCH_BATCH * sizeof(int));
+            double best = -1;
+            for (int r = 0; r <= BENCH_REPEATS; r++) {
+                // Dernier tour: version avec compteurs, pour la correction seulement
+                copy_array(source, work, size);
+                IncrementalSort is;
+                const double start = bench_wall_time();
+                int read = 0;
+                if (r < BENCH_REPEATS) {
+                    incremental_sort_init_uncounted(&is, work, size);
+                    while (read < k) {
+                        const int want = k - read < INCREMENTAL_BENCH_BATCH ? k - read : INCREMENTAL_BENCH_BATCH;
+                        read += incremental_sort_next_batch_uncounted(&is, batch, want);
+                    }
+                } else {
+                    incremental_sort_init(&is, work, size);
+                    while (read < k) {
+                        const int want = k - read < INCREMENTAL_BENCH_BATCH ? k - read : INCREMENTAL_BENCH_BATCH;
+                        read += incremental_sort_next_batch(&is, batch, want);
+                    }
+                }
+                const double time = bench_wall_time() - start;
+
+                if (memcmp(work, sorted, k * sizeof(int)) != 0 ||
+                    memcmp(batch, sorted + k - (k - 1) % INCREMENTAL_BENCH_BATCH - 1,
+                           ((k - 1) % INCREMENTAL_BENCH_BATCH + 1) * sizeof(int)) != 0) {
+                    fprintf(stderr, "Erreur: tri incrémental (%d) faux sur la liste %s\n", k, types[t]);
+                    exit(1);
+                }
+                if (r == BENCH_REPEATS) {
+                    incremental_sort_free(&is);
+                } else {
+                    incremental_sort_free_uncounted(&is);
+                    if (best < 0 || time < best) best = time;
+                }
+            }
+            free(batch);
+
+            char label[64];
+            if (k == size) {
+                snprintf(label, sizeof(label), "tri incrémental (tout)");
+            } else {
+                snprintf(label, sizeof(label), "tri incrémental (k = %d)", k);
+            }
+            printf("%-32s %12.6f %11.2fx\n", label, best, full / best);
+        }
+
+        free(source);
+    }
+
+    free(work);
+    free(sorted);
+}
+
+// Segments de tailles tirées dans [min_size, max_size] jusqu'à total éléments;
+// retourne le nombre de segments (offsets: au plus total + 1 entrées)
+static int make_segments(int offsets[], const int total, const int min_size, const int max_size) {
+    Rng rng;
+    rng_seed(&rng, generator_default_seed());
+    int count = 0;
+    offsets[0] = 0;
+    while (offsets[count] < total) {
+        int size = min_size + (int)rng_bounded(&rng, max_size - min_size + 1);
+        if (size > total - offsets[count]) size = total - offsets[count];
+        offsets[count + 1] = offsets[count] + size;
+        count++;
+    }
+    return count;
+}
+
+// Meilleur temps d'un appel de sort_function par segment
+static double best_per_segment_time(const int source[], int work[], const int offsets[], const int count,
+                                    void (*sort_function)(int[], int)) {
+    double best = -1;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        copy_array((int*)source, work, offsets[count]);
+        const double start = bench_wall_time();
+        for (int s = 0; s < count; s++) {
+            sort_function(work + offsets[s], offsets[s + 1] - offsets[s]);
+        }
+        const double t = bench_wall_time() - start;
+        if (best < 0 || t < best) best = t;
+    }
+    return best;
+}
+
+// Beaucoup de petites listes: un appel par liste contre un seul appel de
+// segmented_sort sur le tampon entier
+static void bench_segments(int size) {
+    if (size < SEGMENTS_BENCH_MIN_SIZE) size = SEGMENTS_BENCH_MIN_SIZE;
+
+    const int ranges[][2] = {{10, 32}, {10, 100}, {10, 1000}};
+    const int num_ranges = sizeof(ranges) / sizeof(ranges[0]);
+
+    const RegisteredSort per_segment[] = {
+        {"insertion_sort_iterative", insertion_sort_iterative_uncounted, 0, 0},
+        {"merge_sort_recursive", merge_sort_recursive_uncounted, 0, 0},
+        {"quick_sort_block", quick_sort_block_uncounted, 0, 0}
+    };
+    const int num_per_segment = sizeof(per_segment) / sizeof(per_segment[0]);
+
+    printf("Tri segmenté (%d éléments aléatoires, %d threads, meilleur de %d essais)\n",
+           size, thread_pool_size(), BENCH_REPEATS);
+
+    int* source = create_array(size, "random");
+    int* work = malloc(size * sizeof(int));
+    int* expected = malloc(size * sizeof(int));
+    int* offsets = malloc((size + 1) * sizeof(int));
+
+    for (int g = 0; g < num_ranges; g++) {
+        const int count = make_segments(offsets, size, ranges[g][0], ranges[g][1]);
+
+        printf("\nSegments de %d à %d éléments (%d segments)\n", ranges[g][0], ranges[g][1], count);
+        printf("----------------------------------------------------------------------------\n");
+        printf("%-32s %12s %14s %12s\n", "Méthode", "Temps (s)", "Méléments/s", "Accélér.");
+        printf("----------------------------------------------------------------------------\n");
+
+        // Référence: chaque segment trié par sort_int32
+        copy_array(source, expected, size);
+        for (int s = 0; s < count; s++) {
+            sort_int32(expected + offsets[s], offsets[s + 1] - offsets[s]);
+        }
+
+        double reference = -1;
+        for (int k = 0; k < num_per_segment; k++) {
+            const double t = best_per_segment_time(source, work, offsets, count, per_segment[k].sort);
+            if (memcmp(work, expected, size * sizeof(int)) != 0) {
+                fprintf(stderr, "Erreur: %s faux sur les segments\n", per_segment[k].name);
+                exit(1);
+            }
+            if (reference < 0) reference = t;
+
+            char label[64];
+            snprintf(label, sizeof(label), "%s (par liste)", per_segment[k].name);
+            printf("%-32s %12.6f %14.1f %11.2fx\n", label, t, size / t / 1e6, reference / t);
+        }
+
+        // Correction de la version avec compteurs
+        copy_array(source, work, size);
+        segmented_sort(work, offsets, count);
+        if (memcmp(work, expected, size * sizeof(int)) != 0) {
+            fprintf(stderr, "Erreur: segmented_sort faux sur les segments\n");
+            exit(1);
+        }
+
+        double best = -1;
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            copy_array(source, work, size);
+            const double start = bench_wall_time();
+            segmented_sort_uncounted(work, offsets, count);
+            const double t = bench_wall_time() - start;
+            if (best < 0 || t < best) best = t;
+        }
+        if (memcmp(work, expected, size * sizeof(int)) != 0) {
+            fprintf(stderr, "Erreur: segmented_sort_uncounted faux sur les segments\n");
+            exit(1);
+        }
+        printf("%-32s %12.6f %14.1f %11.2fx\n", "segmented_sort", best, size / best / 1e6, reference / best);
+    }
+
+    free(source);
+    free(work);
+    free(expected);
+    free(offsets);
+}
+
+// perm est-elle une permutation qui trie keys, indices croissants à clé égale?
+static int is_stable_argsort(const int keys[], const int perm[], const int n, unsigned char seen[]) {
+    memset(seen, 0, n);
+    for (int i = 0; i < n; i++) {
+        if (perm[i] < 0 || perm[i] >= n || seen[perm[i]]) return 0;
+        seen[perm[i]] = 1;
+        if (i > 0 && (keys[perm[i - 1]] > keys[perm[i]] ||
+                      (keys[perm[i - 1]] == keys[perm[i]] && perm[i - 1] > perm[i]))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Tri indirect par les tris de paires de typed_sort.h: construction des
+// paires, tri, extraction des indices
+static void argsort_key_index(const int keys[], const int n, int perm[], KeyIndex pairs[], const int radix) {
+    for (int i = 0; i < n; i++) pairs[i] = (KeyIndex){keys[i], i};
+    if (radix) {
+        radix_sort_key_index(pairs, n);
+    } else {
+        stable_sort_key_index(pairs, n);
+    }
+    for (int i = 0; i < n; i++) perm[i] = (int)pairs[i].index;
+}
+
+// argsort contre les tris stables de paires (clé 64 bits, indice) de
+// typed_sort.h, puis application de la permutation à trois colonnes (int,
+// long long, double): lecture dans l'ordre de perm, naïve ou préchargée, et
+// suivi des cycles en place
+static void bench_argsort(int size) {
+    if (size < ARGSORT_BENCH_MIN_SIZE) size = ARGSORT_BENCH_MIN_SIZE;
+
+    char* types[] = {"sorted", "random", "duplicates", "few_unique"};
+    const int num_types = sizeof(types) / sizeof(types[0]);
+    const char* methods[] = {"argsort", "stable_sort_key_index", "radix_sort_key_index"};
+
+    printf("Tri indirect (n = %d, meilleur de %d essais)\n", size, BENCH_REPEATS);
+
+    int* perm = malloc(size * sizeof(int));
+    KeyIndex* pairs = malloc(size * sizeof(KeyIndex));
+    unsigned char* seen = malloc(size);
+
+    for (int t = 0; t < num_types; t++) {
+        int* keys = create_array(size, types[t]);
+
+        printf("\nType de données: %s\n", types[t]);
+        printf("----------------------------------------------------------------\n");
+        printf("%-32s %12s %12s\n", "Méthode", "Temps (s)", "Accélér.");
+        printf("----------------------------------------------------------------\n");
+
+        // Correction de la version avec compteurs
+        argsort(keys, size, perm);
+        if (!is_stable_argsort(keys, perm, size, seen)) {
+            fprintf(stderr, "Erreur: argsort faux sur la liste %s\n", types[t]);
+            exit(1);
+        }
+
+        double times[3];
+        for (int m = 0; m < 3; m++) {
+            double best = -1;
+            for (int r = 0; r < BENCH_REPEATS; r++) {
+                const double start = bench_wall_time();
+                if (m == 0) {
+                    argsort_uncounted(keys, size, perm);
+                } else {
+                    argsort_key_index(keys, size, perm, pairs, m == 2);
+                }
+                const double time = bench_wall_time() - start;
+                if (best < 0 || time < best) best = time;
+            }
+            if (!is_stable_argsort(keys, perm, size, seen)) {
+                fprintf(stderr, "Erreur: %s faux sur la liste %s\n", methods[m], types[t]);
+                exit(1);
+            }
+            times[m] = best;
+        }
+        for (int m = 0; m < 3; m++) {
+            printf("%-32s %12.6f %11.2fx\n", methods[m], times[m], times[1] / times[m]);
+        }
+        free(keys);
+    }
+
+    // Application de la permutation d'une liste aléatoire à trois colonnes
+    int* keys = create_array(size, "random");
+    argsort_uncounted(keys, size, perm);
+
+    int* ints = malloc(size * sizeof(int));
+    long long* longs = malloc(size * sizeof(long long));
+    double* doubles = malloc(size * sizeof(double));
+    int* expected_ints = malloc(size * sizeof(int));
+    long long* expected_longs = malloc(size * sizeof(long long));
+    double* expected_doubles = malloc(size * sizeof(double));
+    for (int i = 0; i < size; i++) {
+        expected_ints[i] = keys[perm[i]];
+        expected_longs[i] = (long long)keys[perm[i]] * perm[i];
+        expected_doubles[i] = keys[perm[i]] * 0.5;
+    }
+
+    void* columns[] = {ints, longs, doubles};
+    const size_t element_sizes[] = {sizeof(int), sizeof(long long), sizeof(double)};
+
+    printf("\nApplication de la permutation (aléatoire, 3 colonnes: int, long long, double)\n");
+    printf("----------------------------------------------------------------\n");
+    printf("%-32s %12s %12s\n", "Méthode", "Temps (s)", "Accélér.");
+    printf("----------------------------------------------------------------\n");
+
+    const char* apply_methods[] = {"lecture naïve", "apply_permutation", "apply_permutation_cycles"};
+    double reference = -1;
+    for (int m = 0; m < 3; m++) {
+        double best = -1;
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            for (int i = 0; i < size; i++) {
+                ints[i] = keys[i];
+                longs[i] = (long long)keys[i] * i;
+                doubles[i] = keys[i] * 0.5;
+            }
+
+            const double start = bench_wall_time();
+            if (m == 0) {
+                // Référence: une colonne temporaire par colonne, out[i] = column[perm[i]]
+                for (int c = 0; c < 3; c++) {
+                    char* out = malloc(element_sizes[c] * size);
+                    for (int i = 0; i < size; i++) {
+                        memcpy(out + i * element_sizes[c], (char*)columns[c] + perm[i] * element_sizes[c],
+                               element_sizes[c]);
+                    }
+                    memcpy(columns[c], out, element_sizes[c] * size);
+                    free(out);
+                }
+            } else if (m == 1) {
+                apply_permutation_uncounted(perm, size, columns, element_sizes, 3);
+            } else {
+                apply_permutation_cycles_uncounted(perm, size, columns, element_sizes, 3);
+            }
+            const double time = bench_wall_time() - start;
+            if (best < 0 || time < best) best = time;
+        }
+
+        if (memcmp(ints, expected_ints, size * sizeof(int)) != 0 ||
+            memcmp(longs, expected_longs, size * sizeof(long long)) != 0 ||
+            memcmp(doubles, expected_doubles, size * sizeof(double)) != 0) {
+            fprintf(stderr, "Erreur: %s faux\n", apply_methods[m]);
+            exit(1);
+        }
+        if (reference < 0) reference = best;
+        printf("%-32s %12.6f %11.2fx\n", apply_methods[m], best, reference / best);
+    }
+
+    // Correction des versions avec compteurs
+    for (int m = 0; m < 2; m++) {
+        for (int i = 0; i < size; i++) {
+            ints[i] = keys[i];
+            longs[i] = (long long)keys[i] * i;
+            doubles[i] = keys[i] * 0.5;
+        }
+        if (m == 0) {
+            apply_permutation(perm, size, columns, element_sizes, 3);
+        } else {
+            apply_permutation_cycles(perm, size, columns, element_sizes, 3);
+        }
+        if (memcmp(ints, expected_ints, size * sizeof(int)) != 0 ||
+            memcmp(longs, expected_longs, size * sizeof(long long)) != 0 ||
+            memcmp(doubles, expected_doubles, size * sizeof(double)) != 0) {
+            fprintf(stderr, "Erreur: %s (avec compteurs) faux\n", apply_methods[m + 1]);
+            exit(1);
+        }
+    }
+
+    free(keys);
+    free(perm);
+    free(pairs);
+    free(seen);
+    free(ints);
+    free(longs);
+    free(doubles);
+    free(expected_ints);
+    free(expected_longs);
+    free(expected_doubles);
+}
+
+// Calibre sort_auto sur cet hôte (seuils enregistrés, puis relus), puis le
+// compare aux noyaux fixes qu'il peut choisir, sur tous les motifs du générateur
+static void bench_auto(int size) {
+    if (size < AUTO_BENCH_MIN_SIZE) size = AUTO_BENCH_MIN_SIZE;
+
+    printf("Calibration de sort_auto...\n");
+    SortAutoThresholds calibrated;
+    const double start = bench_wall_time();
+    sort_auto_calibrate_uncounted(&calibrated);
+    printf("Calibration en %.1f s\n", bench_wall_time() - start);
+
+    const char* path = sort_auto_calibration_path();
+    SortAutoThresholds reloaded = {0, 0, 0, 0, 0, 0, 0};
+    if (sort_auto_save(path, &calibrated) != 0 || sort_auto_load(path, &reloaded) != 0) {
+        fprintf(stderr, "Erreur: impossible d'enregistrer la calibration dans %s\n", path);
+        exit(1);
+    }
+    sort_auto_set_thresholds(&reloaded);
+
+    printf("Seuils enregistrés dans %s:\n", path);
+    printf("  insertion_max     %d\n", reloaded.insertion_max);
+    printf("  runs_max          %.4f\n", reloaded.runs_max);
+    printf("  inversions_max    %.4f\n", reloaded.inversions_max);
+    printf("  nearly_sorted_max %.4f\n", reloaded.nearly_sorted_max);
+    printf("  duplicates_min    %.4f\n", reloaded.duplicates_min);
+    printf("  radix_min         %d\n", reloaded.radix_min);
+    printf("  parallel_min      %d\n", reloaded.parallel_min);
+
+    const InstrumentedKernel candidates[] = {
+        {"quick_sort_block", quick_sort_block, quick_sort_block_uncounted},
+        {"quick_sort_3way", quick_sort_3way, quick_sort_3way_uncounted},
+        {"radix_sort_lsd", radix_sort_lsd, radix_sort_lsd_uncounted},
+        {"adaptive_sort", adaptive_sort, adaptive_sort_uncounted},
+        {"parallel_sample_sort", parallel_sample_sort, parallel_sample_sort_uncounted}
+    };
+    const int num_candidates = sizeof(candidates) / sizeof(candidates[0]);
+
+    printf("\nsort_auto contre le meilleur noyau fixe (n = %d, meilleur de %d essais)\n", size, BENCH_REPEATS);
+    printf("------------------------------------------------------------------------------------------------------------\n");
+    printf("%-14s %6s %6s %6s %-22s %12s %-22s %12s %8s\n", "Motif", "Séq.", "Inv.", "Doubl.",
+           "Choix", "Temps (s)", "Meilleur fixe", "Temps (s)", "Écart");
+    printf("------------------------------------------------------------------------------------------------------------\n");
+
+    int* source = malloc(size * sizeof(int));
+    int* work = malloc(size * sizeof(int));
+    const uint64_t seed = generator_default_seed();
+
+    for (int p = 0; p < GEN_NUM_PATTERNS; p++) {
+        generate_pattern(source, size, p, seed + p);
+
+        SortAutoProfile profile;
+        sort_auto_profile_uncounted(source, size, &profile);
+
+        const double automatic = best_wall_time(source, work, size, sort_auto_uncounted);
+        if (!is_sorted(work, size)) {
+            fprintf(stderr, "Erreur: sort_auto ne trie pas la liste %s\n", generator_pattern_name(p));
+            exit(1);
+        }
+
+        int best = 0;
+        double best_time_fixed = -1;
+        for (int k = 0; k < num_candidates; k++) {
+            const double t = best_wall_time(source, work, size, candidates[k].uncounted);
+            if (best_time_fixed < 0 || t < best_time_fixed) {
+                best_time_fixed = t;
+                best = k;
+            }
+        }
+
+        printf("%-14s %6.3f %6.3f %6.3f %-22s %12.6f %-22s %12.6f %7.2fx\n", generator_pattern_name(p),
+               profile.run_ratio, profile.inversion_ratio, profile.duplicate_ratio,
+               sort_auto_choice_uncounted(&profile), automatic, candidates[best].name, best_time_fixed,
+               automatic / best_time_fixed);
+    }
+
+    free(source);
+    free(work);
+}
+
+typedef struct {
+    char* name;
+    void (*run)(int size);
+} BenchSuite;
+
+static const BenchSuite suites[] = {
+    {"instrumentation", bench_instrumentation},
+    {"parallel", bench_parallel},
+    {"scaling", bench_scaling},
+    {"partition", bench_partition},
+    {"network", bench_network},
+    {"workspace", bench_workspace},
+    {"merge", bench_merge},
+    {"typed", bench_typed},
+    {"report", bench_report},
+    {"generator", bench_generator},
+    {"selection", bench_selection},
+    {"auto", bench_auto},
+    {"segments", bench_segments},
+    {"argsort", bench_argsort}
+};
+static const int num_suites = sizeof(suites) / sizeof(suites[0]);
+
+// Usage: ./bench_tri [suite|all] [taille]
+// Réglages des mesures (chauffe, essais, cœur, fichier de rapport): voir common/benchmark.h
+// BENCH_MAX_THREADS: nombre maximal de threads des suites parallel et scaling (défaut: les cœurs)
+int main(int argc, char* argv[]) {
+    const char* selected = argc > 1 ? argv[1] : "all";
+    const int size = argc > 2 ? atoi(argv[2]) : BENCH_DEFAULT_SIZE;
+
+    if (size <= 0) {
+        fprintf(stderr, "Taille invalide: %s\n", argv[2]);
+        return 1;
+    }
+
+    // BENCH_CPU: toutes les mesures sur un même cœur
+    BenchConfig config;
+    bench_config_from_env(&config);
+    if (config.cpu >= 0 && bench_pin_cpu(config.cpu) != 0) {
+        fprintf(stderr, "Impossible d'épingler le thread sur le cœur %d\n", config.cpu);
+    }
+
+    int found = 0;
+    for (int s = 0; s < num_suites; s++) {
+        if (strcmp(selected, "all") == 0 || strcmp(selected, suites[s].name) == 0) {
+            printf("=== Benchmark: %s ===\n\n", suites[s].name);
+            suites[s].run(size);
+            printf("\n");
+            found = 1;
+        }
+    }
+
+    if (!found) {
+        fprintf(stderr, "Suite inconnue: %s\nSuites disponibles:", selected);
+        for (int s = 0; s < num_suites; s++) {
+            fprintf(stderr, " %s", suites[s].name);
+        }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,377 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "external_sort.h"
+#include "typed_sort.h"
+
+// Plus petit tampon de lecture par séquence pendant la fusion: en dessous,
+// les lectures deviennent trop petites et le disque passe son temps à chercher
+#define EXTERNAL_MIN_BUFFER (1 << 20)
+
+// Budget minimal: un tampon par séquence et un pour la sortie, fusion 2 à 2
+#define EXTERNAL_MIN_BUDGET (3 * EXTERNAL_MIN_BUFFER)
+
+// Une séquence triée: `length` entiers à partir de l'octet `offset` d'un fichier temporaire
+typedef struct {
+    off_t offset;
+    long length;
+} Run;
+
+// Lecteur d'une séquence par tampons
+typedef struct {
+    int fd;
+    off_t next;
+    long remaining;
+    int* buffer;
+    long capacity;
+    long count;
+    long pos;
+} RunReader;
+
+// Tampon d'écriture séquentielle
+typedef struct {
+    int fd;
+    off_t offset;
+    int* buffer;
+    long capacity;
+    long count;
+} RunWriter;
+
+static int read_fully(const int fd, void* data, size_t bytes, off_t offset) {
+    char* p = data;
+    while (bytes > 0) {
+        const ssize_t r = pread(fd, p, bytes, offset);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return -1;
+        // Fin de fichier avant la fin de la lecture (fichier tronqué)
+        if (r == 0) {
+            errno = EIO;
+            return -1;
+        }
+        p += r;
+        bytes -= r;
+        offset += r;
+    }
+    return 0;
+}
+
+static int write_fully(const int fd, const void* data, size_t bytes, off_t offset) {
+    const char* p = data;
+    while (bytes > 0) {
+        const ssize_t w = pwrite(fd, p, bytes, offset);
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0) return -1;
+        if (w == 0) {
+            errno = EIO;
+            return -1;
+        }
+        p += w;
+        bytes -= w;
+        offset += w;
+    }
+    return 0;
+}
+
+static int writer_flush(RunWriter* writer) {
+    const size_t bytes = writer->count * sizeof(int);
+    if (write_fully(writer->fd, writer->buffer, bytes, writer->offset) != 0) return -1;
+    writer->offset += bytes;
+    writer->count = 0;
+    return 0;
+}
+
+// Recharge le tampon; retourne 1 si des éléments ont été lus, 0 quand la
+// séquence est épuisée et -1 en cas d'erreur de lecture
+static int reader_refill(RunReader* reader) {
+    const long count = reader->remaining < reader->capacity ? reader->remaining : reader->capacity;
+    if (count == 0) return 0;
+
+    if (read_fully(reader->fd, reader->buffer, count * sizeof(int), reader->next) != 0) return -1;
+    reader->next += count * sizeof(int);
+    reader->remaining -= count;
+    reader->count = count;
+    reader->pos = 0;
+    return 1;
+}
+
+// Fusionne les séquences runs[0..k) (lues dans in_fd) en une seule, écrite
+// dans out_fd à partir de out_offset, avec l'arbre des perdants de
+// kway_merge.c (version sans compteurs). Les tampons se partagent `buffer`.
+// Retourne -1 si une lecture ou une écriture échoue.
+static int merge_runs(const int in_fd, const Run runs[], const int k, const int out_fd,
+                      const off_t out_offset, int* buffer, const long buffer_elements) {
+    const long slice = buffer_elements / (k + 1);
+
+    RunReader* readers = malloc(k * sizeof(RunReader));
+    long long* entries = malloc(k * sizeof(long long));
+    int status = 0;
+    for (int r = 0; r < k && status == 0; r++) {
+        readers[r] = (RunReader){in_fd, runs[r].offset, runs[r].length, buffer + r * slice, slice, 0, 0};
+        const int loaded = reader_refill(&readers[r]);
+        if (loaded < 0) status = -1;
+        entries[r] = loaded > 0 ? LOSER_TREE_ENTRY(readers[r].buffer[0], r) : LOSER_TREE_DONE;
+    }
+
+    LoserTree lt;
+    loser_tree_init_uncounted(&lt, k);
+    if (status == 0) loser_tree_build_uncounted(&lt, entries);
+
+    RunWriter writer = {out_fd, out_offset, buffer + k * slice, buffer_elements - k * slice, 0};
+
+    while (status == 0 && lt.tree[0] != LOSER_TREE_DONE) {
+        const int w = LOSER_TREE_SOURCE(lt.tree[0]);
+        RunReader* reader = &readers[w];
+
+        writer.buffer[writer.count++] = LOSER_TREE_KEY(lt.tree[0]);
+        if (writer.count == writer.capacity && writer_flush(&writer) != 0) {
+            status = -1;
+            break;
+        }
+
+        const int loaded = ++reader->pos == reader->count ? reader_refill(reader) : 1;
+        if (loaded < 0) {
+            status = -1;
+            break;
+        }
+        loser_tree_replay_uncounted(&lt, loaded ? LOSER_TREE_ENTRY(reader->buffer[reader->pos], w)
+                                                : LOSER_TREE_DONE);
+    }
+
+    if (status == 0) status = writer_flush(&writer);
+
+    free(readers);
+    free(entries);
+    loser_tree_free_uncounted(&lt);
+    return status;
+}
+
+// Fichier temporaire anonyme (supprimé dès sa création, libéré à sa fermeture)
+static int open_temp_file(const char* dir) {
+    if (dir == NULL) dir = getenv("TMPDIR");
+    if (dir == NULL || *dir == '\0') dir = "/tmp";
+
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/tri_externe_XXXXXX", dir);
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Impossible de créer un fichier temporaire dans %s: %s\n", dir, strerror(errno));
+        return -1;
+    }
+    unlink(path);
+    return fd;
+}
+
+// Le fichier tient dans le budget: on le trie dans une projection de la sortie
+static int sort_in_memory(const int in_fd, const struct stat* in_stat, const char* output,
+                          const ExternalSortConfig* config, const long n) {
+    const size_t bytes = n * sizeof(int);
+
+    // Même fichier: on trie directement sa projection
+    struct stat out_stat;
+    const int same_file = stat(output, &out_stat) == 0 &&
+                          out_stat.st_dev == in_stat->st_dev && out_stat.st_ino == in_stat->st_ino;
+
+    const int out_fd = same_file ? open(output, O_RDWR) : open(output, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s: %s\n", output, strerror(errno));
+        return -1;
+    }
+    if (bytes == 0) {
+        close(out_fd);
+        return 0;
+    }
+    if (!same_file && ftruncate(out_fd, bytes) != 0) {
+        fprintf(stderr, "Impossible d'agrandir %s: %s\n", output, strerror(errno));
+        close(out_fd);
+        return -1;
+    }
+
+    int* out = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, out_fd, 0);
+    if (out == MAP_FAILED) {
+        fprintf(stderr, "Projection de %s impossible: %s\n", output, strerror(errno));
+        close(out_fd);
+        return -1;
+    }
+
+    int status = 0;
+    if (!same_file) {
+        int* in = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, in_fd, 0);
+        if (in == MAP_FAILED) {
+            fprintf(stderr, "Projection de l'entrée impossible: %s\n", strerror(errno));
+            status = -1;
+        } else {
+            madvise(in, bytes, MADV_SEQUENTIAL);
+            memcpy(out, in, bytes);
+            munmap(in, bytes);
+        }
+    }
+
+    if (status == 0) config->sort(out, n);
+
+    munmap(out, bytes);
+    close(out_fd);
+    return status;
+}
+
+// 1. Génération des séquences triées, toutes dans un même fichier temporaire.
+// Retourne le descripteur de ce fichier, ou -1.
+static int create_runs(const int in_fd, const char* input, const ExternalSortConfig* config,
+                       const long n, int* buffer, const long run_elements, Run runs[]) {
+    const int run_fd = open_temp_file(config->temp_dir);
+    if (run_fd < 0) return -1;
+
+    posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    for (long r = 0; r * run_elements < n; r++) {
+        const long begin = r * run_elements;
+        const long length = n - begin < run_elements ? n - begin : run_elements;
+        const off_t offset = (off_t)begin * sizeof(int);
+
+        if (read_fully(in_fd, buffer, length * sizeof(int), offset) != 0) {
+            fprintf(stderr, "Erreur de lecture de %s: %s\n", input, strerror(errno));
+            close(run_fd);
+            return -1;
+        }
+        config->sort(buffer, length);
+        if (write_fully(run_fd, buffer, length * sizeof(int), offset) != 0) {
+            fprintf(stderr, "Erreur d'écriture d'un fichier temporaire: %s\n", strerror(errno));
+            close(run_fd);
+            return -1;
+        }
+        runs[r] = (Run){offset, length};
+    }
+    return run_fd;
+}
+
+// 2. Fusion par paquets de fan_in séquences, tant qu'il en reste plus que ce
+// qu'une passe peut fusionner. Chaque passe écrit un nouveau fichier
+// temporaire; la séquence fusionnée garde l'emplacement de la première.
+// Retourne le descripteur du fichier qui contient les séquences restantes.
+static int merge_passes(int run_fd, const ExternalSortConfig* config, Run runs[], long* num_runs,
+                        const long fan_in, int* buffer, const long buffer_elements,
+                        ExternalSortStats* stats) {
+    while (*num_runs > fan_in) {
+        const int next_fd = open_temp_file(config->temp_dir);
+        if (next_fd < 0) {
+            close(run_fd);
+            return -1;
+        }
+
+        long merged = 0;
+        for (long first = 0; first < *num_runs; first += fan_in) {
+            const int k = *num_runs - first < fan_in ? *num_runs - first : fan_in;
+            if (merge_runs(run_fd, runs + first, k, next_fd, runs[first].offset,
+                           buffer, buffer_elements) != 0) {
+                fprintf(stderr, "Erreur de fusion des fichiers temporaires: %s\n", strerror(errno));
+                close(next_fd);
+                close(run_fd);
+                return -1;
+            }
+
+            long length = 0;
+            for (int r = 0; r < k; r++) length += runs[first + r].length;
+            runs[merged++] = (Run){runs[first].offset, length};
+        }
+
+        close(run_fd);
+        run_fd = next_fd;
+        *num_runs = merged;
+        stats->merge_passes++;
+    }
+    return run_fd;
+}
+
+static int sort_out_of_core(const int in_fd, const char* input, const char* output,
+                            const ExternalSortConfig* config, const long n,
+                            int* buffer, const long run_elements, ExternalSortStats* stats) {
+    long num_runs = (n + run_elements - 1) / run_elements;
+    Run* runs = malloc(num_runs * sizeof(Run));
+    stats->runs = num_runs;
+
+    int run_fd = create_runs(in_fd, input, config, n, buffer, run_elements, runs);
+
+    // Un tampon d'au moins EXTERNAL_MIN_BUFFER octets par séquence, plus la sortie
+    long fan_in = config->memory_budget / EXTERNAL_MIN_BUFFER - 1;
+    if (fan_in < 2) fan_in = 2;
+    if (run_fd >= 0) {
+        run_fd = merge_passes(run_fd, config, runs, &num_runs, fan_in, buffer, run_elements, stats);
+    }
+    if (run_fd < 0) {
+        free(runs);
+        return -1;
+    }
+
+    // Dernière passe: directement dans le fichier de sortie
+    const int out_fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int status = -1;
+    if (out_fd < 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s: %s\n", output, strerror(errno));
+    } else {
+        status = merge_runs(run_fd, runs, num_runs, out_fd, 0, buffer, run_elements);
+        if (status != 0) fprintf(stderr, "Erreur de fusion vers %s: %s\n", output, strerror(errno));
+        stats->merge_passes++;
+        close(out_fd);
+    }
+
+    close(run_fd);
+    free(runs);
+    return status;
+}
+
+int external_sort_file(const char* input, const char* output,
+                       const ExternalSortConfig* user_config, ExternalSortStats* stats) {
+    ExternalSortConfig config = *user_config;
+    if (config.sort == NULL) config.sort = sort_int32;
+    if (config.memory_budget < EXTERNAL_MIN_BUDGET) config.memory_budget = EXTERNAL_MIN_BUDGET;
+
+    ExternalSortStats local_stats;
+    if (stats == NULL) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    const int in_fd = open(input, O_RDONLY);
+    if (in_fd < 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s: %s\n", input, strerror(errno));
+        return -1;
+    }
+
+    struct stat in_stat;
+    if (fstat(in_fd, &in_stat) != 0 || in_stat.st_size % sizeof(int) != 0) {
+        fprintf(stderr, "%s n'est pas un fichier d'entiers 32 bits\n", input);
+        close(in_fd);
+        return -1;
+    }
+
+    const long n = in_stat.st_size / sizeof(int);
+    stats->elements = n;
+
+    // Les noyaux en mémoire prennent une taille de type int
+    long run_elements = config.memory_budget / sizeof(int);
+    if (run_elements > INT_MAX) run_elements = INT_MAX;
+
+    if (n <= run_elements) {
+        stats->in_memory = 1;
+        stats->runs = n > 0;
+        const int status = sort_in_memory(in_fd, &in_stat, output, &config, n);
+        close(in_fd);
+        return status;
+    }
+
+    int* buffer = malloc(run_elements * sizeof(int));
+    if (buffer == NULL) {
+        fprintf(stderr, "Budget mémoire trop grand: allocation impossible\n");
+        close(in_fd);
+        return -1;
+    }
+
+    const int status = sort_out_of_core(in_fd, input, output, &config, n, buffer, run_elements, stats);
+    close(in_fd);
+    free(buffer);
+    return status;
+}
@@ -0,0 +1,39 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <stddef.h>
+
+// Tri externe de fichiers binaires d'entiers 32 bits (ordre des octets de la
+// machine), plus grands que la mémoire (external_sort.c).
+//
+// Si le fichier tient dans le budget mémoire, il est projeté (mmap) et trié
+// sur place dans le fichier de sortie. Sinon:
+//   1. génération des séquences: le fichier est lu par blocs de la taille du
+//      budget, chaque bloc est trié en mémoire puis écrit dans un fichier
+//      temporaire;
+//   2. fusion: les séquences sont fusionnées k à k par un arbre des perdants,
+//      chacune lue par grands tampons séquentiels. Si elles sont trop
+//      nombreuses pour le budget, on fait plusieurs passes de fusion.
+
+typedef struct {
+    // Octets de mémoire utilisables (tampons de lecture et d'écriture compris)
+    size_t memory_budget;
+    // Répertoire des fichiers temporaires (NULL: $TMPDIR, sinon /tmp)
+    const char* temp_dir;
+    // Tri en mémoire des séquences (NULL: sort_int32)
+    void (*sort)(int arr[], int n);
+} ExternalSortConfig;
+
+typedef struct {
+    long elements;
+    long runs;
+    int merge_passes;
+    int in_memory;
+} ExternalSortStats;
+
+// Trie input dans output (qui peut être le même fichier).
+// Retourne 0, ou -1 après un message sur stderr. stats peut être NULL.
+int external_sort_file(const char* input, const char* output,
+                       const ExternalSortConfig* config, ExternalSortStats* stats);
+
+#endif
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri_composite.h"
+
+// Séquences fusionnées à chaque passe de merge_sort_kway: log2(16) = 4
+// comparaisons par élément et par passe, comme quatre passes à 2 voies, mais
+// une seule lecture et une seule écriture de la liste
+#define KWAY_FAN_IN 16
+
+// Feuilles triées par insertion avant la première passe
+#define KWAY_LEAF 16
+
+void loser_tree_init(LoserTree* lt, const int k) {
+    lt->k = k;
+    lt->tree = malloc((k > 0 ? k : 1) * sizeof(long long));
+}
+
+void loser_tree_free(LoserTree* lt) {
+    free(lt->tree);
+    lt->tree = NULL;
+}
+
+// Joue le sous-arbre de `node` et retourne l'entrée gagnante
+static long long loser_tree_play(LoserTree* lt, const long long entries[], const int node) {
+    if (node >= lt->k) return entries[node - lt->k];
+
+    const long long left = loser_tree_play(lt, entries, 2 * node);
+    const long long right = loser_tree_play(lt, entries, 2 * node + 1);
+    if (COUNT_COMPARISON(right < left)) {
+        lt->tree[node] = left;
+        return right;
+    }
+    lt->tree[node] = right;
+    return left;
+}
+
+void loser_tree_build(LoserTree* lt, const long long entries[]) {
+    lt->tree[0] = lt->k > 0 ? loser_tree_play(lt, entries, 1) : LOSER_TREE_DONE;
+}
+
+// Rejoue les matchs du chemin du vainqueur jusqu'à la racine: le plus petit
+// des deux continue, l'autre reste dans le noeud (sélections sans branchement)
+void loser_tree_replay(LoserTree* lt, long long entry) {
+    const int source = LOSER_TREE_SOURCE(lt->tree[0]);
+    for (int node = (source + lt->k) / 2; node >= 1; node /= 2) {
+        const long long loser = lt->tree[node];
+        const int swap = COUNT_COMPARISON(loser < entry);
+        lt->tree[node] = swap ? entry : loser;
+        entry = swap ? loser : entry;
+    }
+    lt->tree[0] = entry;
+}
+
+// Fusionne les sources [heads[s], ends[s]) (lt->k sources) dans out;
+// entries (lt->k cases) reçoit les têtes des sources
+static void merge_spans(LoserTree* lt, const int* heads[], const int* ends[], long long entries[], int out[]) {
+    for (int s = 0; s < lt->k; s++) {
+        entries[s] = heads[s] == ends[s] ? LOSER_TREE_DONE : LOSER_TREE_ENTRY(*heads[s], s);
+    }
+    loser_tree_build(lt, entries);
+
+    while (lt->tree[0] != LOSER_TREE_DONE) {
+        const int w = LOSER_TREE_SOURCE(lt->tree[0]);
+        *out++ = LOSER_TREE_KEY(lt->tree[0]);
+        COUNT_SWAP();
+
+        loser_tree_replay(lt, ++heads[w] == ends[w] ? LOSER_TREE_DONE : LOSER_TREE_ENTRY(*heads[w], w));
+    }
+}
+
+void kway_merge(const int* spans[], const int lengths[], const int k, int out[]) {
+    if (k <= 0) return;
+
+    const int** heads = malloc(k * sizeof(int*));
+    const int** ends = malloc(k * sizeof(int*));
+    long long* entries = malloc(k * sizeof(long long));
+    for (int s = 0; s < k; s++) {
+        heads[s] = spans[s];
+        ends[s] = spans[s] + lengths[s];
+    }
+
+    LoserTree lt;
+    loser_tree_init(&lt, k);
+    merge_spans(&lt, heads, ends, entries, out);
+    loser_tree_free(&lt);
+
+    free(heads);
+    free(ends);
+    free(entries);
+}
+
+// Tri Fusion à k voies
+void merge_sort_kway(int arr[], const int n) {
+    merge_sort_kway_ws(arr, n, thread_workspace());
+}
+
+// Tri Fusion ascendant à KWAY_FAN_IN voies: ceil(log_k(n / KWAY_LEAF))
+// passes sur la mémoire au lieu de ceil(log2(n / KWAY_LEAF)), les passes
+// alternant entre arr et le tampon de ws
+void merge_sort_kway_ws(int arr[], const int n, SortWorkspace* ws) {
+    for (int i = 0; i < n; i += KWAY_LEAF) {
+        insertion_sort_iterative(arr + i, n - i < KWAY_LEAF ? n - i : KWAY_LEAF);
+    }
+    if (n <= KWAY_LEAF) return;
+
+    int* src = arr;
+    int* dst = workspace_reserve(ws, n);
+
+    long long tree[KWAY_FAN_IN];
+    LoserTree lt = {KWAY_FAN_IN, tree};
+    const int* heads[KWAY_FAN_IN];
+    const int* ends[KWAY_FAN_IN];
+    long long entries[KWAY_FAN_IN];
+
+    for (long width = KWAY_LEAF; width < n; width *= KWAY_FAN_IN) {
+        for (long start = 0; start < n; start += width * KWAY_FAN_IN) {
+            int k = 0;
+            for (long s = start; s < n && k < KWAY_FAN_IN; s += width) {
+                heads[k] = src + s;
+                ends[k] = src + (s + width < n ? s + width : n);
+                k++;
+            }
+
+            // Séquences déjà dans l'ordre (ou une seule, en fin de liste):
+            // simple recopie
+            int ordered = 1;
+            for (int r = 1; r < k && ordered; r++) {
+                ordered = COUNT_COMPARISON(ends[r - 1][-1] <= *heads[r]);
+            }
+            if (ordered) {
+                const long length = ends[k - 1] - heads[0];
+                memcpy(dst + start, heads[0], length * sizeof(int));
+                COUNT_SWAPS(length);
+                continue;
+            }
+
+            // Séquences dans l'ordre inverse (liste décroissante): recopie
+            // de la dernière à la première
+            int reversed = 1;
+            for (int r = 1; r < k && reversed; r++) {
+                reversed = COUNT_COMPARISON(ends[r][-1] < *heads[r - 1]);
+            }
+            if (reversed) {
+                int* out = dst + start;
+                for (int r = k - 1; r >= 0; r--) {
+                    memcpy(out, heads[r], (ends[r] - heads[r]) * sizeof(int));
+                    out += ends[r] - heads[r];
+                }
+                COUNT_SWAPS(out - (dst + start));
+                continue;
+            }
+
+            lt.k = k;
+            merge_spans(&lt, heads, ends, entries, dst + start);
+        }
+
+        int* swap_buffers = src;
+        src = dst;
+        dst = swap_buffers;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+        COUNT_SWAPS(n);
+    }
+}
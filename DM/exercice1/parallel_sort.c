@@ -0,0 +1,631 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "tri_composite.h"
+#include "thread_pool.h"
+
+#define INTRO_MAX_SPAWNS 64
+
+#ifndef SORT_UNCOUNTED
+// Taille en dessous de laquelle un sous-tableau (ou une fusion) est traité en série
+int parallel_merge_cutoff = PARALLEL_MERGE_DEFAULT_CUTOFF;
+
+// Taille minimale d'une partition pour qu'elle devienne une tâche du pool
+int parallel_quick_cutoff = PARALLEL_QUICK_DEFAULT_CUTOFF;
+#endif
+
+// Compteurs d'un appel parallèle. Chaque feuille mesure ses opérations sur
+// son thread puis les ajoute ici; l'appelant les récupère à la fin.
+typedef struct {
+    atomic_ulong comparisons;
+    atomic_ulong swaps;
+} SharedStats;
+
+static void leaf_begin(SortStats* before) {
+    read_counters(before);
+}
+
+// Transfère les opérations de la feuille vers l'appel et restaure les
+// compteurs du thread (qui peut être l'appelant lui-même).
+static void leaf_end(SharedStats* shared, const SortStats* before) {
+    atomic_fetch_add_explicit(&shared->comparisons, comparisons - before->comparisons,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&shared->swaps, swaps - before->swaps, memory_order_relaxed);
+    comparisons = before->comparisons;
+    swaps = before->swaps;
+}
+
+// Fusion stable de left[0..nl) et right[0..nr) dans out
+static void merge_runs(const int left[], const int nl, const int right[], const int nr, int out[]) {
+    int i = 0;
+    int j = 0;
+    int k = 0;
+
+    while (i < nl && j < nr) {
+        if (COUNT_COMPARISON(right[j] < left[i])) {
+            out[k++] = right[j++];
+        } else {
+            out[k++] = left[i++];
+        }
+        COUNT_SWAP();
+    }
+
+    // On copie les éléments restants
+    memcpy(out + k, left + i, (nl - i) * sizeof(int));
+    k += nl - i;
+    memcpy(out + k, right + j, (nr - j) * sizeof(int));
+    COUNT_SWAPS(nl - i + nr - j);
+}
+
+// Tri fusion série en ping-pong: trie src[0..n) et laisse le résultat dans
+// dst si to_dst, sinon dans src. L'autre tableau sert de tampon.
+static void serial_merge_sort(int src[], int dst[], const int n, const int to_dst) {
+    if (n <= SORT_NETWORK_MAX) {
+        sort_network(src, n);
+        if (to_dst) {
+            memcpy(dst, src, n * sizeof(int));
+            COUNT_SWAPS(n);
+        }
+        return;
+    }
+
+    const int half = n / 2;
+    serial_merge_sort(src, dst, half, !to_dst);
+    serial_merge_sort(src + half, dst + half, n - half, !to_dst);
+
+    if (to_dst) {
+        merge_runs(src, half, src + half, n - half, dst);
+    } else {
+        merge_runs(dst, half, dst + half, n - half, src);
+    }
+}
+
+// Premier indice de arr[0..n) dont la valeur est >= key
+static int lower_bound(const int arr[], const int n, const int key) {
+    int low = 0;
+    int high = n;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (COUNT_COMPARISON(arr[mid] < key)) low = mid + 1; else high = mid;
+    }
+    return low;
+}
+
+// Premier indice de arr[0..n) dont la valeur est > key
+static int upper_bound(const int arr[], const int n, const int key) {
+    int low = 0;
+    int high = n;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (COUNT_COMPARISON(key < arr[mid])) high = mid; else low = mid + 1;
+    }
+    return low;
+}
+
+typedef struct {
+    const int* left;
+    int nl;
+    const int* right;
+    int nr;
+    int* out;
+    SharedStats* stats;
+} MergeTask;
+
+// Fusion parallèle: on coupe la plus longue séquence en son milieu, on cherche
+// le point de coupe correspondant dans l'autre, et les deux moitiés de la
+// sortie sont fusionnées indépendamment.
+static void parallel_merge(void* arg) {
+    const MergeTask* m = arg;
+    SortStats before;
+
+    if (m->nl + m->nr <= parallel_merge_cutoff) {
+        leaf_begin(&before);
+        merge_runs(m->left, m->nl, m->right, m->nr, m->out);
+        leaf_end(m->stats, &before);
+        return;
+    }
+
+    // Les égalités restent du côté gauche pour garder la fusion stable
+    int lm;
+    int rm;
+    leaf_begin(&before);
+    if (m->nl >= m->nr) {
+        lm = m->nl / 2;
+        rm = lower_bound(m->right, m->nr, m->left[lm]);
+    } else {
+        rm = m->nr / 2;
+        lm = upper_bound(m->left, m->nl, m->right[rm]);
+    }
+    leaf_end(m->stats, &before);
+
+    MergeTask first = {m->left, lm, m->right, rm, m->out, m->stats};
+    MergeTask second = {m->left + lm, m->nl - lm, m->right + rm, m->nr - rm,
+                        m->out + lm + rm, m->stats};
+
+    Task task;
+    task_spawn(&task, parallel_merge, &first);
+    parallel_merge(&second);
+    task_wait(&task);
+}
+
+typedef struct {
+    int* src;
+    int* dst;
+    int n;
+    int to_dst;
+    SharedStats* stats;
+} SortTask;
+
+// Même convention que serial_merge_sort: le résultat est dans dst si to_dst
+static void parallel_sort(void* arg) {
+    const SortTask* t = arg;
+    SortStats before;
+
+    if (t->n <= parallel_merge_cutoff) {
+        leaf_begin(&before);
+        serial_merge_sort(t->src, t->dst, t->n, t->to_dst);
+        leaf_end(t->stats, &before);
+        return;
+    }
+
+    const int half = t->n / 2;
+
+    // La moitié gauche est publiée pour être volée, la droite est faite ici
+    SortTask left = {t->src, t->dst, half, !t->to_dst, t->stats};
+    SortTask right = {t->src + half, t->dst + half, t->n - half, !t->to_dst, t->stats};
+
+    Task task;
+    task_spawn(&task, parallel_sort, &left);
+    parallel_sort(&right);
+    task_wait(&task);
+
+    // Les deux moitiés triées sont dans l'autre tableau: on les fusionne vers la cible
+    int* from = t->to_dst ? t->src : t->dst;
+    int* into = t->to_dst ? t->dst : t->src;
+    MergeTask merge_task = {from, half, from + half, t->n - half, into, t->stats};
+    parallel_merge(&merge_task);
+}
+
+// Tri Fusion parallèle (pool de threads à vol de tâches)
+void parallel_merge_sort(int arr[], const int n) {
+    parallel_merge_sort_ws(arr, n, thread_workspace());
+}
+
+// Tri Fusion parallèle; le tampon de l'appelant est partagé par toutes les
+// tâches (chacune n'en touche que sa tranche)
+void parallel_merge_sort_ws(int arr[], const int n, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    int* temp = workspace_reserve(ws, n);
+    SharedStats shared = {0, 0};
+
+    SortTask root = {arr, temp, n, 0, &shared};
+    parallel_sort(&root);
+
+    // Les opérations de toutes les feuilles sont attribuées au thread appelant
+    const SortStats total = {atomic_load(&shared.comparisons), atomic_load(&shared.swaps)};
+    merge_counters(&total);
+}
+
+typedef struct {
+    int* arr;
+    int low;
+    int high;
+    int depth_limit;
+    SharedStats* stats;
+} IntroTask;
+
+// Tri Rapide introspectif sur arr[low..high]. On ne s'appelle récursivement
+// que sur le plus petit côté et on boucle sur le plus grand, ce qui borne la
+// pile à O(log n). Au-delà de depth_limit partitions, le reste passe au tri
+// par tas: O(n log n) garanti même sur les entrées triées ou inversées.
+// Les intervalles d'au plus SORT_NETWORK_MAX éléments finissent dans un réseau de tri.
+static void intro_sort(void* arg) {
+    const IntroTask* t = arg;
+    int* arr = t->arr;
+    int low = t->low;
+    int high = t->high;
+    int depth_limit = t->depth_limit;
+    SortStats before;
+
+    // Partitions confiées au pool, attendues avant de retourner
+    Task tasks[INTRO_MAX_SPAWNS];
+    IntroTask children[INTRO_MAX_SPAWNS];
+    int num_spawned = 0;
+
+    while (high - low + 1 > SORT_NETWORK_MAX) {
+        if (depth_limit == 0) {
+            leaf_begin(&before);
+            heap_sort(arr + low, high - low + 1);
+            leaf_end(t->stats, &before);
+            low = high + 1;
+            break;
+        }
+        depth_limit--;
+
+        leaf_begin(&before);
+        const int pivot_index = partition_median(arr, low, high);
+        leaf_end(t->stats, &before);
+
+        // Le plus petit côté est traité à part, le plus grand reste dans la boucle
+        IntroTask smaller;
+        if (pivot_index - low < high - pivot_index) {
+            smaller = (IntroTask){arr, low, pivot_index - 1, depth_limit, t->stats};
+            low = pivot_index + 1;
+        } else {
+            smaller = (IntroTask){arr, pivot_index + 1, high, depth_limit, t->stats};
+            high = pivot_index - 1;
+        }
+
+        if (smaller.high - smaller.low + 1 >= parallel_quick_cutoff && num_spawned < INTRO_MAX_SPAWNS) {
+            children[num_spawned] = smaller;
+            task_spawn(&tasks[num_spawned], intro_sort, &children[num_spawned]);
+            num_spawned++;
+        } else {
+            intro_sort(&smaller);
+        }
+    }
+
+    if (low < high) {
+        leaf_begin(&before);
+        sort_network(arr + low, high - low + 1);
+        leaf_end(t->stats, &before);
+    }
+
+    for (int i = 0; i < num_spawned; i++) {
+        task_wait(&tasks[i]);
+    }
+}
+
+// Tri Rapide introspectif parallèle (médiane de trois, garde-fou tri par tas)
+void quick_sort_intro(int arr[], const int n) {
+    if (n <= 1) return;
+
+    // Profondeur maximale: 2 * floor(log2(n))
+    int depth_limit = 0;
+    for (int m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+
+    SharedStats shared = {0, 0};
+    IntroTask root = {arr, 0, n - 1, depth_limit, &shared};
+    intro_sort(&root);
+
+    const SortStats total = {atomic_load(&shared.comparisons), atomic_load(&shared.swaps)};
+    merge_counters(&total);
+}
+
+// Tri par échantillonnage (sample sort) parallèle.
+// 1. On tire SAMPLE_SORT_OVERSAMPLING éléments par seau, on les trie et on
+//    garde un séparateur tous les SAMPLE_SORT_OVERSAMPLING: les seaux ont
+//    presque tous la même taille, même sur une entrée biaisée.
+// 2. Chaque bloc du tableau classe ses éléments (recherche sans branchement
+//    dans l'arbre implicite des séparateurs) et compte ses seaux.
+// 3. Préfixes des histogrammes (seau, bloc): chaque bloc disperse ses
+//    éléments dans un tampon de sortie unique, sans synchronisation.
+// 4. Chaque seau est trié par le meilleur noyau série (quick_sort_block)
+//    puis recopié à sa place dans arr. Les éléments égaux à un séparateur
+//    vont dans un seau d'égalité, déjà trié: beaucoup de doublons ne
+//    déséquilibrent pas les seaux.
+#define SAMPLE_SORT_OVERSAMPLING 32
+#define SAMPLE_SORT_BUCKETS_PER_THREAD 8
+// 2 * SAMPLE_SORT_MAX_BUCKETS classes doivent tenir dans un octet
+#define SAMPLE_SORT_MAX_BUCKETS 128
+#define SAMPLE_SORT_MIN_BUCKET 4096
+#define SAMPLE_SORT_MAX_BLOCKS 256
+#define SAMPLE_SORT_BLOCK_SIZE (1 << 16)
+#define SAMPLE_SORT_MAX_TASKS (SAMPLE_SORT_MAX_BLOCKS > 2 * SAMPLE_SORT_MAX_BUCKETS ? \
+                               SAMPLE_SORT_MAX_BLOCKS : 2 * SAMPLE_SORT_MAX_BUCKETS)
+
+typedef struct {
+    int* arr;
+    int* out;
+    unsigned char* classes;
+    int n;
+    int num_buckets;
+    int log_buckets;
+    int num_blocks;
+    // Séparateurs triés, puis le même ensemble en arbre implicite (tree[1..num_buckets))
+    int splitters[SAMPLE_SORT_MAX_BUCKETS];
+    int tree[SAMPLE_SORT_MAX_BUCKETS];
+    // counts[block * 2 * num_buckets + classe], puis position d'écriture
+    int* counts;
+    // Début de chaque classe dans out (2 * num_buckets + 1 bornes)
+    int bounds[2 * SAMPLE_SORT_MAX_BUCKETS + 1];
+    SharedStats* stats;
+} SampleSort;
+
+typedef struct {
+    SampleSort* sort;
+    int index;
+} SampleSortTask;
+
+static void block_range(const SampleSort* s, const int block, int* begin, int* end) {
+    *begin = (long)s->n * block / s->num_blocks;
+    *end = (long)s->n * (block + 1) / s->num_blocks;
+}
+
+// Parcours infixe: l'arbre implicite reçoit les séparateurs dans l'ordre
+static void build_splitter_tree(SampleSort* s, const int node, int* next) {
+    if (node >= s->num_buckets) return;
+    build_splitter_tree(s, 2 * node, next);
+    s->tree[node] = s->splitters[(*next)++];
+    build_splitter_tree(s, 2 * node + 1, next);
+}
+
+// Classe 2b: splitters[b-1] < x < splitters[b]; classe 2b+1: x == splitters[b]
+static inline int classify(const SampleSort* s, const int x) {
+    int j = 1;
+    for (int level = 0; level < s->log_buckets; level++) {
+        j = 2 * j + (x > s->tree[j]);
+    }
+    const int b = j - s->num_buckets;
+    return 2 * b + (b < s->num_buckets - 1 && x == s->splitters[b]);
+}
+
+static void sample_sort_classify(void* arg) {
+    const SampleSortTask* t = arg;
+    const SampleSort* s = t->sort;
+    int* counts = s->counts + t->index * 2 * s->num_buckets;
+    int begin;
+    int end;
+    block_range(s, t->index, &begin, &end);
+
+    for (int i = begin; i < end; i++) {
+        const int c = classify(s, s->arr[i]);
+        s->classes[i] = c;
+        counts[c]++;
+    }
+
+    SortStats before;
+    leaf_begin(&before);
+    COUNT_COMPARISONS((unsigned long)(end - begin) * (s->log_buckets + 1));
+    leaf_end(s->stats, &before);
+}
+
+static void sample_sort_scatter(void* arg) {
+    const SampleSortTask* t = arg;
+    const SampleSort* s = t->sort;
+    int* positions = s->counts + t->index * 2 * s->num_buckets;
+    int begin;
+    int end;
+    block_range(s, t->index, &begin, &end);
+
+    for (int i = begin; i < end; i++) {
+        s->out[positions[s->classes[i]]++] = s->arr[i];
+    }
+
+    SortStats before;
+    leaf_begin(&before);
+    COUNT_SWAPS(end - begin);
+    leaf_end(s->stats, &before);
+}
+
+static void sample_sort_bucket(void* arg) {
+    const SampleSortTask* t = arg;
+    const SampleSort* s = t->sort;
+    const int begin = s->bounds[t->index];
+    const int size = s->bounds[t->index + 1] - begin;
+    SortStats before;
+
+    leaf_begin(&before);
+    // Les seaux d'égalité (indices impairs) sont déjà triés
+    if (t->index % 2 == 0) {
+        quick_sort_block(s->out + begin, size);
+    }
+    memcpy(s->arr + begin, s->out + begin, size * sizeof(int));
+    COUNT_SWAPS(size);
+    leaf_end(s->stats, &before);
+}
+
+// Lance run(tasks[i]) pour i < count sur le pool et attend la fin de toutes
+static void run_all(void (*run)(void*), SampleSortTask tasks[], const int count) {
+    Task handles[SAMPLE_SORT_MAX_TASKS];
+    for (int i = 1; i < count; i++) {
+        task_spawn(&handles[i], run, &tasks[i]);
+    }
+    if (count > 0) run(&tasks[0]);
+    for (int i = 1; i < count; i++) {
+        task_wait(&handles[i]);
+    }
+}
+
+// Indice pseudo-aléatoire de l'échantillon (mélange de splitmix64): pas de
+// motif régulier qu'une entrée structurée pourrait aligner
+static int sample_index(const int i, const int n) {
+    unsigned long long x = (unsigned long long)i * 0x9E3779B97F4A7C15ull + (unsigned)n;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return (int)((x ^ (x >> 31)) % (unsigned)n);
+}
+
+// Tri par échantillonnage parallèle
+void parallel_sample_sort(int arr[], const int n) {
+    parallel_sample_sort_ws(arr, n, thread_workspace());
+}
+
+void parallel_sample_sort_ws(int arr[], const int n, SortWorkspace* ws) {
+    // Nombre de seaux: une puissance de deux, quelques seaux par thread pour
+    // équilibrer la charge, sans descendre sous SAMPLE_SORT_MIN_BUCKET éléments
+    int num_buckets = 1;
+    int log_buckets = 0;
+    const int wanted = thread_pool_size() * SAMPLE_SORT_BUCKETS_PER_THREAD;
+    while (num_buckets < wanted && num_buckets < SAMPLE_SORT_MAX_BUCKETS &&
+           2L * num_buckets * SAMPLE_SORT_MIN_BUCKET <= n) {
+        num_buckets *= 2;
+        log_buckets++;
+    }
+
+    if (num_buckets < 2) {
+        quick_sort_block(arr, n);
+        return;
+    }
+
+    int num_blocks = (n + SAMPLE_SORT_BLOCK_SIZE - 1) / SAMPLE_SORT_BLOCK_SIZE;
+    if (num_blocks > SAMPLE_SORT_MAX_BLOCKS) num_blocks = SAMPLE_SORT_MAX_BLOCKS;
+
+    // Tampon de sortie, histogrammes, échantillon et classes (un octet par élément)
+    const int sample_size = num_buckets * SAMPLE_SORT_OVERSAMPLING;
+    const size_t out_bytes = (size_t)n * sizeof(int);
+    const size_t counts_bytes = (size_t)num_blocks * 2 * num_buckets * sizeof(int);
+    const size_t sample_bytes = (size_t)sample_size * sizeof(int);
+    char* buffer = workspace_reserve_bytes(ws, out_bytes + counts_bytes + sample_bytes + n);
+
+    SharedStats shared = {0, 0};
+    SampleSort sort;
+    SampleSort* s = &sort;
+    s->arr = arr;
+    s->out = (int*)buffer;
+    s->counts = (int*)(buffer + out_bytes);
+    s->classes = (unsigned char*)(buffer + out_bytes + counts_bytes + sample_bytes);
+    s->n = n;
+    s->num_buckets = num_buckets;
+    s->log_buckets = log_buckets;
+    s->num_blocks = num_blocks;
+    s->stats = &shared;
+    memset(s->counts, 0, counts_bytes);
+
+    // 1. Échantillon trié, un séparateur tous les SAMPLE_SORT_OVERSAMPLING
+    int* sample = (int*)(buffer + out_bytes + counts_bytes);
+    for (int i = 0; i < sample_size; i++) {
+        sample[i] = arr[sample_index(i, n)];
+    }
+    quick_sort_block(sample, sample_size);
+    for (int b = 0; b < num_buckets - 1; b++) {
+        s->splitters[b] = sample[(b + 1) * SAMPLE_SORT_OVERSAMPLING - 1];
+    }
+
+    int next = 0;
+    build_splitter_tree(s, 1, &next);
+
+    // Une tâche par bloc (étapes 2 et 3) ou par classe (étape 4)
+    SampleSortTask tasks[SAMPLE_SORT_MAX_TASKS];
+    for (int i = 0; i < SAMPLE_SORT_MAX_TASKS; i++) {
+        tasks[i] = (SampleSortTask){s, i};
+    }
+
+    // 2. Classement et histogrammes par bloc
+    run_all(sample_sort_classify, tasks, num_blocks);
+
+    // 3. Positions d'écriture: classe par classe, puis bloc par bloc
+    int offset = 0;
+    for (int c = 0; c < 2 * num_buckets; c++) {
+        s->bounds[c] = offset;
+        for (int block = 0; block < num_blocks; block++) {
+            int* count = &s->counts[block * 2 * num_buckets + c];
+            const int size = *count;
+            *count = offset;
+            offset += size;
+        }
+    }
+    s->bounds[2 * num_buckets] = n;
+    run_all(sample_sort_scatter, tasks, num_blocks);
+
+    // 4. Tri local de chaque seau et recopie dans arr
+    run_all(sample_sort_bucket, tasks, 2 * num_buckets);
+
+    const SortStats total = {atomic_load(&shared.comparisons), atomic_load(&shared.swaps)};
+    merge_counters(&total);
+}
+
+// Tri segmenté: chaque segment data[offsets[s]..offsets[s+1]) est trié
+// indépendamment, sans allocation. Les segments sont traités par lots de
+// SEGMENT_BATCH; dans un lot, on les range par classe de taille (réseaux de
+// 8, 16 et 32, puis quick_sort_block au-delà de SORT_NETWORK_MAX) et chaque
+// classe est triée d'un bloc: le même noyau, la même taille de réseau et les
+// mêmes branches d'un segment au suivant. Les tâches du pool reçoivent des
+// tranches de segments contiguës et de même volume.
+#define SEGMENT_BATCH 256
+#define SEGMENT_CLASSES 4
+#define SEGMENT_MIN_CHUNK (1 << 15)
+#define SEGMENT_CHUNKS_PER_THREAD 4
+#define SEGMENT_MAX_CHUNKS 256
+
+typedef struct {
+    int* data;
+    const int* offsets;
+    int first;
+    int last;
+    SharedStats* stats;
+} SegmentTask;
+
+static void sort_segments(void* arg) {
+    const SegmentTask* t = arg;
+    SortStats before;
+    // Classes 0, 1, 2: réseaux de 8, 16 et 32; classe 3: quick_sort_block
+    int classes[SEGMENT_CLASSES][SEGMENT_BATCH];
+
+    leaf_begin(&before);
+    for (int batch = t->first; batch < t->last; batch += SEGMENT_BATCH) {
+        const int end = batch + SEGMENT_BATCH < t->last ? batch + SEGMENT_BATCH : t->last;
+        int counts[SEGMENT_CLASSES] = {0};
+
+        for (int s = batch; s < end; s++) {
+            const int size = t->offsets[s + 1] - t->offsets[s];
+            const int c = (size > 8) + (size > 16) + (size > SORT_NETWORK_MAX);
+            classes[c][counts[c]++] = s;
+        }
+
+        for (int c = 0; c < SEGMENT_CLASSES - 1; c++) {
+            for (int i = 0; i < counts[c]; i++) {
+                const int s = classes[c][i];
+                sort_network(t->data + t->offsets[s], t->offsets[s + 1] - t->offsets[s]);
+            }
+        }
+        for (int i = 0; i < counts[SEGMENT_CLASSES - 1]; i++) {
+            const int s = classes[SEGMENT_CLASSES - 1][i];
+            quick_sort_block(t->data + t->offsets[s], t->offsets[s + 1] - t->offsets[s]);
+        }
+    }
+    leaf_end(t->stats, &before);
+}
+
+// Premier segment dont le début est >= target (offsets croissants)
+static int segment_at(const int offsets[], const int num_segments, const long target) {
+    int low = 0;
+    int high = num_segments;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (offsets[mid] < target) low = mid + 1; else high = mid;
+    }
+    return low;
+}
+
+// Trie chaque segment data[offsets[s]..offsets[s+1]) pour s < num_segments
+// (offsets a num_segments + 1 entrées, croissantes)
+void segmented_sort(int data[], const int offsets[], const int num_segments) {
+    if (num_segments <= 0) return;
+
+    const long total = offsets[num_segments] - offsets[0];
+    long chunks = (long)thread_pool_size() * SEGMENT_CHUNKS_PER_THREAD;
+    if (chunks > total / SEGMENT_MIN_CHUNK) chunks = total / SEGMENT_MIN_CHUNK;
+    if (chunks > SEGMENT_MAX_CHUNKS) chunks = SEGMENT_MAX_CHUNKS;
+
+    SharedStats shared = {0, 0};
+    if (chunks <= 1) {
+        SegmentTask all = {data, offsets, 0, num_segments, &shared};
+        sort_segments(&all);
+    } else {
+        // Tranches de même volume: les bornes sont cherchées dans offsets
+        SegmentTask tasks[SEGMENT_MAX_CHUNKS];
+        Task handles[SEGMENT_MAX_CHUNKS];
+        int first = 0;
+        for (int c = 0; c < chunks; c++) {
+            const int last = c == chunks - 1 ? num_segments
+                : segment_at(offsets, num_segments, offsets[0] + total * (c + 1) / chunks);
+            tasks[c] = (SegmentTask){data, offsets, first, last, &shared};
+            first = last;
+        }
+        for (int c = 1; c < chunks; c++) {
+            task_spawn(&handles[c], sort_segments, &tasks[c]);
+        }
+        sort_segments(&tasks[0]);
+        for (int c = 1; c < chunks; c++) {
+            task_wait(&handles[c]);
+        }
+    }
+
+    const SortStats total_stats = {atomic_load(&shared.comparisons), atomic_load(&shared.swaps)};
+    merge_counters(&total_stats);
+}
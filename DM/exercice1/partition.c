@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include "tri_composite.h"
+
+// Taille d'un bloc de BlockQuicksort (les décalages tiennent sur un octet)
+#define PARTITION_BLOCK 128
+#define AVX2_LANES 8
+
+// Partition par blocs sans branchement (BlockQuicksort, Edelkamp & Weiß).
+// Même contrat que partition_classic (pivot arr[low], retourne sa position
+// finale) sauf que les éléments égaux au pivot peuvent aller des deux côtés:
+// arr[low..p-1] <= pivot <= arr[p+1..high].
+//
+// Au lieu d'un `if` par élément, on mémorise dans deux tampons les positions
+// des éléments mal placés d'un bloc à gauche et d'un bloc à droite; l'index
+// avance d'un booléen, ce qui ne dépend d'aucune prédiction.
+int partition_block(int arr[], const int low, const int high) {
+    const int pivot = arr[low];
+    unsigned char offsets_left[PARTITION_BLOCK];
+    unsigned char offsets_right[PARTITION_BLOCK];
+    int start_left = 0;
+    int start_right = 0;
+    int num_left = 0;
+    int num_right = 0;
+
+    int l = low + 1;
+    int r = high;
+
+    while (r - l + 1 > 2 * PARTITION_BLOCK) {
+        // Éléments >= pivot dans le bloc de gauche
+        if (num_left == 0) {
+            start_left = 0;
+            for (int i = 0; i < PARTITION_BLOCK; i++) {
+                offsets_left[num_left] = (unsigned char)i;
+                num_left += !(arr[l + i] < pivot);
+            }
+            COUNT_COMPARISONS(PARTITION_BLOCK);
+        }
+
+        // Éléments <= pivot dans le bloc de droite
+        if (num_right == 0) {
+            start_right = 0;
+            for (int i = 0; i < PARTITION_BLOCK; i++) {
+                offsets_right[num_right] = (unsigned char)i;
+                num_right += !(pivot < arr[r - i]);
+            }
+            COUNT_COMPARISONS(PARTITION_BLOCK);
+        }
+
+        // On échange les paires d'éléments mal placés
+        const int num = num_left < num_right ? num_left : num_right;
+        for (int j = 0; j < num; j++) {
+            const int a = l + offsets_left[start_left + j];
+            const int b = r - offsets_right[start_right + j];
+            const int temp = arr[a];
+            arr[a] = arr[b];
+            arr[b] = temp;
+        }
+        COUNT_SWAPS(num);
+
+        num_left -= num;
+        num_right -= num;
+        start_left += num;
+        start_right += num;
+
+        if (num_left == 0) l += PARTITION_BLOCK;
+        if (num_right == 0) r -= PARTITION_BLOCK;
+    }
+
+    // Reste (au plus deux blocs, éventuellement déjà en partie traités):
+    // partition de Hoare classique sur arr[l..r]
+    int i = l;
+    int j = r;
+    while (1) {
+        while (i <= j && COUNT_COMPARISON(arr[i] < pivot)) i++;
+        while (i <= j && COUNT_COMPARISON(pivot < arr[j])) j--;
+        if (i >= j) break;
+
+        const int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+        COUNT_SWAP();
+        i++;
+        j--;
+    }
+
+    // arr[low+1..i-1] <= pivot et arr[i..high] >= pivot
+    const int p = i - 1;
+    arr[low] = arr[p];
+    arr[p] = pivot;
+    COUNT_SWAP();
+
+    return p;
+}
+
+// Table de permutation pour la compression AVX2: pour chaque masque de 8 bits,
+// les voies sélectionnées d'abord (dans l'ordre), puis les autres.
+static int compress_table[256][AVX2_LANES];
+static pthread_once_t compress_table_once = PTHREAD_ONCE_INIT;
+
+static void build_compress_table(void) {
+    for (int mask = 0; mask < 256; mask++) {
+        int k = 0;
+        for (int lane = 0; lane < AVX2_LANES; lane++) {
+            if (mask & (1 << lane)) compress_table[mask][k++] = lane;
+        }
+        for (int lane = 0; lane < AVX2_LANES; lane++) {
+            if (!(mask & (1 << lane))) compress_table[mask][k++] = lane;
+        }
+    }
+}
+
+// Range un vecteur: les voies < pivot à *left_write, les autres juste avant
+// *right_write. Les deux écritures font 8 voies: l'appelant garantit au moins
+// 8 cases libres de chaque côté.
+__attribute__((target("avx2")))
+static inline void partition_vector(const __m256i v, const __m256i pivots,
+                                    int** left_write, int** right_write) {
+    const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivots, v)));
+    const int num_less = __builtin_popcount(mask);
+
+    const __m256i permutation = _mm256_loadu_si256((const __m256i*)compress_table[mask]);
+    const __m256i packed = _mm256_permutevar8x32_epi32(v, permutation);
+
+    _mm256_storeu_si256((__m256i*)*left_write, packed);
+    _mm256_storeu_si256((__m256i*)(*right_write - AVX2_LANES), packed);
+
+    *left_write += num_less;
+    *right_write -= AVX2_LANES - num_less;
+}
+
+// Partition AVX2 en place par compression (voir Bramas, 2017).
+// Contrat de partition_classic: arr[low..p-1] < pivot <= arr[p+1..high].
+//
+// Les deux premiers vecteurs (un à chaque bout) sont chargés d'avance pour
+// libérer 16 cases; on lit ensuite toujours du côté qui a le moins de place,
+// ce qui garde au moins 8 cases libres de chaque côté pour les écritures.
+__attribute__((target("avx2")))
+int partition_avx2(int arr[], const int low, const int high) {
+    const int n = high - low;
+    if (n < 2 * AVX2_LANES) {
+        return partition_classic(arr, low, high);
+    }
+    pthread_once(&compress_table_once, build_compress_table);
+
+    const int pivot = arr[low];
+    const __m256i pivots = _mm256_set1_epi32(pivot);
+
+    int* left_read = arr + low + 1;
+    int* right_read = arr + high + 1;
+    int* left_write = left_read;
+    int* right_write = right_read;
+
+    const __m256i first = _mm256_loadu_si256((const __m256i*)left_read);
+    left_read += AVX2_LANES;
+    right_read -= AVX2_LANES;
+    const __m256i last = _mm256_loadu_si256((const __m256i*)right_read);
+
+    while (right_read - left_read >= AVX2_LANES) {
+        __m256i v;
+        if (left_read - left_write <= right_write - right_read) {
+            v = _mm256_loadu_si256((const __m256i*)left_read);
+            left_read += AVX2_LANES;
+        } else {
+            right_read -= AVX2_LANES;
+            v = _mm256_loadu_si256((const __m256i*)right_read);
+        }
+        partition_vector(v, pivots, &left_write, &right_write);
+    }
+
+    // Tout ce qui reste à placer (deux vecteurs d'avance et < 8 éléments)
+    // passe par un tampon: plus aucune lecture ne peut être écrasée.
+    int rest[3 * AVX2_LANES];
+    const int tail = (int)(right_read - left_read);
+    _mm256_storeu_si256((__m256i*)rest, first);
+    _mm256_storeu_si256((__m256i*)(rest + AVX2_LANES), last);
+    memcpy(rest + 2 * AVX2_LANES, left_read, tail * sizeof(int));
+
+    for (int i = 0; i < 2 * AVX2_LANES + tail; i++) {
+        if (rest[i] < pivot) {
+            *left_write++ = rest[i];
+        } else {
+            *--right_write = rest[i];
+        }
+    }
+
+    COUNT_COMPARISONS(n);
+    COUNT_SWAPS(n);
+
+    // On place le pivot entre les deux zones
+    const int p = (int)(left_write - arr) - 1;
+    arr[low] = arr[p];
+    arr[p] = pivot;
+    COUNT_SWAP();
+
+    return p;
+}
+
+static int (*partition_impl)(int[], int, int) = NULL;
+static pthread_once_t partition_impl_once = PTHREAD_ONCE_INIT;
+
+static void select_partition(void) {
+    __builtin_cpu_init();
+    partition_impl = __builtin_cpu_supports("avx2") ? partition_avx2 : partition_block;
+}
+
+// Partition la plus rapide disponible, choisie une fois selon CPUID
+int partition_fast(int arr[], const int low, const int high) {
+    pthread_once(&partition_impl_once, select_partition);
+    return partition_impl(arr, low, high);
+}
+
+#ifndef SORT_UNCOUNTED
+// Nom de la partition retenue par partition_fast (pour les rapports)
+const char* partition_fast_name(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? "AVX2" : "blocs";
+}
+#endif
+
+#define NINTHER_THRESHOLD 128
+
+// Ordonne arr[a] <= arr[b] <= arr[c]
+static void sort_three(int arr[], const int a, const int b, const int c) {
+    if (COUNT_COMPARISON(arr[b] < arr[a])) {
+        const int temp = arr[b]; arr[b] = arr[a]; arr[a] = temp;
+        COUNT_SWAP();
+    }
+    if (COUNT_COMPARISON(arr[c] < arr[b])) {
+        const int temp = arr[c]; arr[c] = arr[b]; arr[b] = temp;
+        COUNT_SWAP();
+        if (COUNT_COMPARISON(arr[b] < arr[a])) {
+            const int temp2 = arr[b]; arr[b] = arr[a]; arr[a] = temp2;
+            COUNT_SWAP();
+        }
+    }
+}
+
+// Place le pivot en arr[low]: médiane de trois prise aux quartiles, ou
+// pseudo-médiane de neuf (Tukey) sur les grands intervalles. On évite les
+// extrémités: la partition AVX2 y dépose les derniers éléments traités, ce
+// qui piège une médiane (premier, milieu, dernier) sur les listes triées.
+static void choose_pivot(int arr[], const int low, const int high) {
+    const int quarter = (high - low + 1) / 4;
+    const int mid = low + (high - low) / 2;
+    const int a = low + quarter;
+    const int b = high - quarter;
+
+    if (high - low + 1 > NINTHER_THRESHOLD) {
+        sort_three(arr, a - 1, a, a + 1);
+        sort_three(arr, mid - 1, mid, mid + 1);
+        sort_three(arr, b - 1, b, b + 1);
+    }
+    sort_three(arr, a, mid, b);
+
+    const int temp = arr[low];
+    arr[low] = arr[mid];
+    arr[mid] = temp;
+    COUNT_SWAP();
+}
+
+static void quick_sort_block_impl(int arr[], int low, int high, int depth_limit) {
+    while (high - low + 1 > SORT_NETWORK_MAX) {
+        if (depth_limit-- == 0) {
+            heap_sort(arr + low, high - low + 1);
+            return;
+        }
+
+        choose_pivot(arr, low, high);
+        const int pivot_index = partition_fast(arr, low, high);
+
+        // Récursion sur le plus petit côté, boucle sur le plus grand
+        if (pivot_index - low < high - pivot_index) {
+            quick_sort_block_impl(arr, low, pivot_index - 1, depth_limit);
+            low = pivot_index + 1;
+        } else {
+            quick_sort_block_impl(arr, pivot_index + 1, high, depth_limit);
+            high = pivot_index - 1;
+        }
+    }
+
+    if (low < high) {
+        sort_network(arr + low, high - low + 1);
+    }
+}
+
+// Tri Rapide sur la partition sans branchement (AVX2 ou par blocs)
+void quick_sort_block(int arr[], const int n) {
+    int depth_limit = 0;
+    for (int m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+    quick_sort_block_impl(arr, 0, n - 1, depth_limit);
+}
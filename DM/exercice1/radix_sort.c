@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri_composite.h"
+
+#define RADIX_MAX_BITS 11
+#define RADIX_MAX_PASSES 4
+#define MSD_BITS 8
+#define MSD_BUCKETS (1 << MSD_BITS)
+#define MSD_INSERTION_CUTOFF 64
+
+// Les clés signées sont triées comme des non signées dont on a inversé le bit
+// de signe: INT_MIN devient 0 et INT_MAX devient 0xFFFFFFFF.
+static inline unsigned int radix_key(const int value) {
+    return (unsigned int)value ^ 0x80000000u;
+}
+
+// Tri par base LSD sur des chiffres de `bits` bits. Tous les histogrammes
+// sont calculés en une seule lecture, et un passage dont tous les éléments
+// tombent dans le même seau est sauté (ex: octets de poids fort des petites
+// valeurs).
+static void lsd_radix_sort(int arr[], const int n, const int bits, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    const int buckets = 1 << bits;
+    const unsigned int mask = buckets - 1;
+    const int passes = (32 + bits - 1) / bits;
+    int counts[RADIX_MAX_PASSES][1 << RADIX_MAX_BITS];
+    memset(counts, 0, sizeof(counts));
+
+    // Histogramme de tous les chiffres en un seul passage
+    for (int i = 0; i < n; i++) {
+        const unsigned int key = radix_key(arr[i]);
+        for (int p = 0; p < passes; p++) {
+            counts[p][(key >> (p * bits)) & mask]++;
+        }
+    }
+
+    int* temp = workspace_reserve(ws, n);
+    int* src = arr;
+    int* dst = temp;
+
+    for (int p = 0; p < passes; p++) {
+        const int shift = p * bits;
+        int* count = counts[p];
+
+        // Passage trivial: tous les éléments ont le même chiffre
+        if (count[(radix_key(src[0]) >> shift) & mask] == n) {
+            continue;
+        }
+
+        // Sommes préfixes: position de départ de chaque seau
+        int offset = 0;
+        for (int b = 0; b < buckets; b++) {
+            const int c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+
+        // Distribution stable vers l'autre tableau
+        for (int i = 0; i < n; i++) {
+            const int value = src[i];
+            dst[count[(radix_key(value) >> shift) & mask]++] = value;
+        }
+        COUNT_SWAPS(n);
+
+        int* swap_buffers = src;
+        src = dst;
+        dst = swap_buffers;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+        COUNT_SWAPS(n);
+    }
+}
+
+// Tri par base LSD, chiffres de 8 bits (4 passages au plus)
+void radix_sort_lsd(int arr[], const int n) {
+    lsd_radix_sort(arr, n, 8, thread_workspace());
+}
+
+// Tri par base LSD, chiffres de 11 bits (3 passages au plus, pour les grands n)
+void radix_sort_lsd11(int arr[], const int n) {
+    lsd_radix_sort(arr, n, 11, thread_workspace());
+}
+
+// Mêmes tris avec un espace de travail fourni par l'appelant
+void radix_sort_lsd_ws(int arr[], const int n, SortWorkspace* ws) {
+    lsd_radix_sort(arr, n, 8, ws);
+}
+
+void radix_sort_lsd11_ws(int arr[], const int n, SortWorkspace* ws) {
+    lsd_radix_sort(arr, n, 11, ws);
+}
+
+static inline int msd_digit(const int value, const int shift) {
+    return (radix_key(value) >> shift) & (MSD_BUCKETS - 1);
+}
+
+// Tri « American flag »: tri par base MSD en place. Chaque élément est
+// déplacé directement vers son seau en suivant les cycles de la permutation,
+// sans tableau auxiliaire.
+static void american_flag_sort(int arr[], const int n, const int shift) {
+    if (n <= SORT_NETWORK_MAX) {
+        sort_network(arr, n);
+        return;
+    }
+    if (n <= MSD_INSERTION_CUTOFF) {
+        insertion_sort_iterative(arr, n);
+        return;
+    }
+
+    int count[MSD_BUCKETS] = {0};
+    for (int i = 0; i < n; i++) {
+        count[msd_digit(arr[i], shift)]++;
+    }
+
+    // Un seul seau non vide: on passe directement au chiffre suivant
+    if (count[msd_digit(arr[0], shift)] == n) {
+        if (shift > 0) american_flag_sort(arr, n, shift - MSD_BITS);
+        return;
+    }
+
+    int head[MSD_BUCKETS];
+    int tail[MSD_BUCKETS];
+    int offset = 0;
+    for (int b = 0; b < MSD_BUCKETS; b++) {
+        head[b] = offset;
+        offset += count[b];
+        tail[b] = offset;
+    }
+
+    // Permutation en place par cycles
+    for (int b = 0; b < MSD_BUCKETS; b++) {
+        while (head[b] < tail[b]) {
+            int value = arr[head[b]];
+            int digit = msd_digit(value, shift);
+
+            while (digit != b) {
+                const int displaced = arr[head[digit]];
+                arr[head[digit]++] = value;
+                COUNT_SWAP();
+                value = displaced;
+                digit = msd_digit(value, shift);
+            }
+            arr[head[b]++] = value;
+        }
+    }
+
+    if (shift == 0) return;
+
+    // Chaque seau est trié sur le chiffre suivant
+    int start = 0;
+    for (int b = 0; b < MSD_BUCKETS; b++) {
+        if (count[b] > 1) {
+            american_flag_sort(arr + start, count[b], shift - MSD_BITS);
+        }
+        start += count[b];
+    }
+}
+
+// Tri par base MSD en place (American flag), chiffres de 8 bits
+void radix_sort_msd(int arr[], const int n) {
+    if (n <= 1) return;
+    american_flag_sort(arr, n, 32 - MSD_BITS);
+}
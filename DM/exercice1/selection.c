@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri_composite.h"
+
+// Intervalles finis par un tri par insertion
+#define SELECT_INSERTION_CUTOFF 16
+
+// Taille des groupes de la médiane des médianes
+#define SELECT_GROUP 5
+
+static inline void swap_ints(int arr[], const int i, const int j) {
+    const int temp = arr[i];
+    arr[i] = arr[j];
+    arr[j] = temp;
+    COUNT_SWAP();
+}
+
+static void select_impl(int arr[], int low, int high, int k);
+
+// Partition de [low, high] déséquilibrée: plus de 7/8 des éléments avant
+// first ou après last (calcul en long: pas de débordement au-delà de 2^28)
+static inline int lopsided(const int low, const int first, const int last, const int high) {
+    return (long)(first - low) * 8 < high - low || (long)(high - last) * 8 < high - low;
+}
+
+// Médiane de arr[a], arr[b], arr[c] placée en arr[low] (pivot de partition_fast)
+static void median_of_three(int arr[], const int low, const int a, const int b, const int c) {
+    int m = b;
+    if (COUNT_COMPARISON(arr[a] < arr[b])) {
+        if (COUNT_COMPARISON(arr[c] < arr[b])) m = COUNT_COMPARISON(arr[a] < arr[c]) ? c : a;
+    } else if (COUNT_COMPARISON(arr[b] < arr[c])) {
+        m = COUNT_COMPARISON(arr[a] < arr[c]) ? a : c;
+    }
+    swap_ints(arr, low, m);
+}
+
+// Médiane des médianes de groupes de SELECT_GROUP: le pivot laisse au moins
+// 3/10 des éléments de chaque côté, d'où O(n) dans le pire cas. Les médianes
+// sont rassemblées au début de l'intervalle; le pivot est placé en arr[low].
+static void median_of_medians(int arr[], const int low, const int high) {
+    int groups = 0;
+
+    for (int first = low; first <= high; first += SELECT_GROUP) {
+        const int size = high - first + 1 < SELECT_GROUP ? high - first + 1 : SELECT_GROUP;
+        insertion_sort_iterative(arr + first, size);
+        swap_ints(arr, low + groups, first + size / 2);
+        groups++;
+    }
+
+    select_impl(arr, low, low + groups - 1, low + groups / 2);
+    swap_ints(arr, low, low + groups / 2);
+}
+
+// Sélection introspective (Musser): médiane de trois (aux quartiles, comme
+// quick_sort_block) et partition_fast, mais l'intervalle doit diminuer de
+// moitié tous les deux partitionnements; sinon le suivant prend la médiane
+// des médianes et partition_classic. Quand une partition est
+// déséquilibrée, les éléments égaux au pivot sont regroupés à côté de lui:
+// une entrée pleine de doublons progresse quand même.
+static void select_impl(int arr[], int low, int high, const int k) {
+    int checkpoint = high - low + 1;
+    int rounds = 0;
+    int fallback = 0;
+
+    while (high - low + 1 > SELECT_INSERTION_CUTOFF) {
+        int p;
+        if (fallback) {
+            median_of_medians(arr, low, high);
+            p = partition_classic(arr, low, high);
+        } else {
+            const int quarter = (high - low + 1) / 4;
+            median_of_three(arr, low, low + quarter, low + (high - low) / 2, high - quarter);
+            p = partition_fast(arr, low, high);
+        }
+
+        // Plus de 7/8 d'un côté: on rassemble les égaux au pivot juste après lui
+        int equal_end = p;
+        if (lopsided(low, p, p, high)) {
+            for (int i = p + 1; i <= high; i++) {
+                if (COUNT_COMPARISON(arr[i] == arr[p])) {
+                    swap_ints(arr, i, ++equal_end);
+                }
+            }
+        }
+
+        if (k < p) {
+            high = p - 1;
+        } else if (k > equal_end) {
+            low = equal_end + 1;
+        } else {
+            return;
+        }
+
+        if (++rounds == 2) {
+            fallback = (long)(high - low + 1) * 2 > checkpoint;
+            checkpoint = high - low + 1;
+            rounds = 0;
+        }
+    }
+
+    if (low < high) {
+        insertion_sort_iterative(arr + low, high - low + 1);
+    }
+}
+
+// Place en arr[k] l'élément de rang k de l'ordre croissant; avant lui des
+// éléments <=, après lui des éléments >=. O(n) en moyenne et dans le pire cas.
+void nth_element(int arr[], const int n, const int k) {
+    if (k < 0 || k >= n) return;
+    select_impl(arr, 0, n - 1, k);
+}
+
+// Les k plus petits éléments, triés, dans arr[0..k); le reste dans un ordre
+// quelconque. O(n + k log k).
+void partial_sort(int arr[], const int n, int k) {
+    if (k <= 0 || n <= 1) return;
+    if (k > n) k = n;
+
+    if (k < n) nth_element(arr, n, k - 1);
+    quick_sort_block(arr, k);
+}
+
+// Sélection en flux: un tampon de 2k valeurs; quand il est plein, une
+// sélection garde les k plus petites (O(k)), soit O(1) amorti par valeur.
+// Les valeurs supérieures ou égales au seuil (la k-ième gardée) sont
+// écartées sans être copiées.
+void topk_init(TopK* topk, const int k) {
+    topk->k = k > 0 ? k : 1;
+    topk->buffer = malloc(2 * topk->k * sizeof(int));
+    topk->count = 0;
+    topk->threshold = 0;
+    topk->full = 0;
+}
+
+void topk_push(TopK* topk, const int values[], const int n) {
+    for (int i = 0; i < n; i++) {
+        if (topk->full && COUNT_COMPARISON(values[i] >= topk->threshold)) continue;
+
+        topk->buffer[topk->count++] = values[i];
+        if (topk->count == 2 * topk->k) {
+            nth_element(topk->buffer, topk->count, topk->k - 1);
+            topk->count = topk->k;
+            topk->threshold = topk->buffer[topk->k - 1];
+            topk->full = 1;
+        }
+    }
+}
+
+// Écrit les min(k, valeurs vues) plus petites valeurs triées dans out et
+// retourne leur nombre
+int topk_result(TopK* topk, int out[]) {
+    const int count = topk->count < topk->k ? topk->count : topk->k;
+    partial_sort(topk->buffer, topk->count, count);
+    memcpy(out, topk->buffer, count * sizeof(int));
+    return count;
+}
+
+void topk_free(TopK* topk) {
+    free(topk->buffer);
+    topk->buffer = NULL;
+}
+
+// Tri incrémental (Paredes et Navarro): les k plus petits éléments, dans
+// l'ordre, en O(n + k log k) en moyenne, sans trier le reste. On garde une
+// pile de blocs de pivots déjà à leur place, du plus à droite (sentinelle
+// en n) au plus proche de sorted_end: entre sorted_end et le bloc du
+// sommet, une partition non triée. Pour avancer, on la coupe par
+// partition_median jusqu'à ce que le morceau de tête soit assez petit pour
+// un tri par insertion; les pivots restent sur la pile pour les appels
+// suivants. Comme dans select_impl, une partition très déséquilibrée
+// rassemble les égaux au pivot (ils sont aussi à leur place); si elle le
+// reste, la suivante prend la médiane des médianes: la médiane de trois de
+// partition_median est quadratique sur certaines entrées (organ_pipe).
+#define INCREMENTAL_INSERTION_CUTOFF 16
+#define INCREMENTAL_STACK_INIT 64
+
+void incremental_sort_init(IncrementalSort* is, int arr[], const int n) {
+    is->arr = arr;
+    is->n = n > 0 ? n : 0;
+    is->next = 0;
+    is->sorted_end = 0;
+    is->fallback = 0;
+    is->capacity = INCREMENTAL_STACK_INIT;
+    is->stack = malloc(2 * is->capacity * sizeof(int));
+
+    // Sentinelle: un bloc vide en n, jamais retiré
+    is->stack[0] = is->n;
+    is->stack[1] = is->n - 1;
+    is->top = 1;
+}
+
+static void incremental_push(IncrementalSort* is, const int begin, const int end) {
+    if (is->top == is->capacity) {
+        is->capacity *= 2;
+        is->stack = realloc(is->stack, 2 * is->capacity * sizeof(int));
+    }
+    is->stack[2 * is->top] = begin;
+    is->stack[2 * is->top + 1] = end;
+    is->top++;
+}
+
+// Trie arr[0..target) en place (target <= n)
+static void incremental_sort_until(IncrementalSort* is, const int target) {
+    int* arr = is->arr;
+
+    while (is->sorted_end < target) {
+        const int block_begin = is->stack[2 * (is->top - 1)];
+        const int block_end = is->stack[2 * (is->top - 1) + 1];
+
+        // Plus rien avant le bloc du sommet: ses pivots sont à leur place
+        if (is->sorted_end == block_begin) {
+            is->sorted_end = block_end + 1;
+            is->top--;
+            continue;
+        }
+
+        const int low = is->sorted_end;
+        const int high = block_begin - 1;
+        if (high - low + 1 <= INCREMENTAL_INSERTION_CUTOFF) {
+            insertion_sort_iterative(arr + low, high - low + 1);
+            is->sorted_end = block_begin;
+            continue;
+        }
+
+        // Partition entièrement lue par ce lot: un tri complet, par le noyau le plus rapide
+        if (block_begin <= target) {
+            quick_sort_block(arr + low, high - low + 1);
+            is->sorted_end = block_begin;
+            continue;
+        }
+
+        int p;
+        if (is->fallback) {
+            median_of_medians(arr, low, high);
+            p = partition_classic(arr, low, high);
+        } else {
+            p = partition_median(arr, low, high);
+        }
+
+        // Plus de 7/8 d'un côté: les égaux au pivot sont rassemblés juste après lui
+        int equal_end = p;
+        if (lopsided(low, p, p, high)) {
+            for (int i = p + 1; i <= high; i++) {
+                if (COUNT_COMPARISON(arr[i] == arr[p])) {
+                    swap_ints(arr, i, ++equal_end);
+                }
+            }
+        }
+
+        // Toujours déséquilibrée: la partition suivante prend la médiane des médianes
+        is->fallback = lopsided(low, p, equal_end, high);
+        incremental_push(is, p, equal_end);
+    }
+}
+
+// Copie dans out les (au plus) k éléments suivants de l'ordre croissant et
+// retourne leur nombre (0 quand tout a été lu). Ils sont aussi à leur place
+// dans le tableau: arr[0..next) est trié.
+int incremental_sort_next_batch(IncrementalSort* is, int out[], const int k) {
+    const int count = k < is->n - is->next ? (k > 0 ? k : 0) : is->n - is->next;
+
+    incremental_sort_until(is, is->next + count);
+    memcpy(out, is->arr + is->next, count * sizeof(int));
+    is->next += count;
+    return count;
+}
+
+// Itérateur: élément suivant dans *value, 0 quand tout a été lu
+int incremental_sort_next(IncrementalSort* is, int* value) {
+    return incremental_sort_next_batch(is, value, 1);
+}
+
+void incremental_sort_free(IncrementalSort* is) {
+    free(is->stack);
+    is->stack = NULL;
+}
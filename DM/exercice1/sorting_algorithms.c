@@ -1,16 +1,20 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "tri_composite.h"
 
+// Taille des feuilles du tri fusion en ping-pong (triées par insertion)
+#define PINGPONG_LEAF 16
+
 // Tri par insertion itératif
 void insertion_sort_iterative(int arr[], const int n) {
     for (int i = 1; i < n; i++) {
         const int key = arr[i];
         int j = i - 1;
 
-        while (j >= 0 && (++comparisons && arr[j] > key)) {
+        while (j >= 0 && COUNT_COMPARISON(arr[j] > key)) {
             arr[j + 1] = arr[j];
-            swaps++;
+            COUNT_SWAP();
             j--;
         }
 
@@ -29,9 +33,9 @@ void insertion_sort_recursive(int arr[], const int n) {
     const int last = arr[n - 1];
     int j = n - 2;
 
-    while (j >= 0 && (++comparisons && arr[j] > last)) {
+    while (j >= 0 && COUNT_COMPARISON(arr[j] > last)) {
         arr[j + 1] = arr[j];
-        swaps++;
+        COUNT_SWAP();
         j--;
     }
 
@@ -40,12 +44,17 @@ void insertion_sort_recursive(int arr[], const int n) {
 
 // Tri Fusion récursif
 void merge_sort_recursive(int arr[], const int n) {
+    merge_sort_recursive_ws(arr, n, thread_workspace());
+}
+
+// Tri Fusion récursif, liste temporaire prise dans l'espace de travail ws
+void merge_sort_recursive_ws(int arr[], const int n, SortWorkspace* ws) {
+    if (n <= 1) return;
+
     // Liste temporaire pour la fusion
-    int* temp = malloc(n * sizeof(int));
+    int* temp = workspace_reserve(ws, n);
 
     merge_sort_recursive_impl(arr, temp, 0, n - 1);
-
-    free(temp);
 }
 
 // Tri Fusion récursif (méthode auxiliaire)
@@ -64,7 +73,7 @@ void merge_sort_recursive_impl(int arr[], int temp[], const int left, const int
 
 // Fonction de fusion pour le tri fusion
 void merge(int arr[], int temp[], const int left, const int mid, const int right) {
-    copy_array(arr, temp, right-left);
+    copy_array(arr + left, temp + left, right - left + 1);
 
     int i = left;
     int j = mid + 1;
@@ -72,31 +81,37 @@ void merge(int arr[], int temp[], const int left, const int mid, const int right
 
     // Fusion des sub-listes
     while (i <= mid && j <= right) {
-        comparisons++;
-        if (temp[i] <= temp[j]) {
+        if (COUNT_COMPARISON(temp[i] <= temp[j])) {
             arr[k++] = temp[i++];
         } else {
             arr[k++] = temp[j++];
         }
-        swaps++;
+        COUNT_SWAP();
     }
 
     // On copie les éléments restants de la liste gauche
     while (i <= mid) {
         arr[k++] = temp[i++];
-        swaps++;
+        COUNT_SWAP();
     }
 
     // On copie les éléments restants de la liste droite
     while (j <= right) {
         arr[k++] = temp[j++];
-        swaps++;
+        COUNT_SWAP();
     }
 }
 
 // Tri Fusion itératif
-void merge_sort_iterative(int arr[], int n) {
-    int* temp = malloc(n * sizeof(int));
+void merge_sort_iterative(int arr[], const int n) {
+    merge_sort_iterative_ws(arr, n, thread_workspace());
+}
+
+// Tri Fusion itératif, liste temporaire prise dans l'espace de travail ws
+void merge_sort_iterative_ws(int arr[], const int n, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    int* temp = workspace_reserve(ws, n);
 
     // On commence avec les listes de taille 1 et on continue de doubler
     for (int curr_size = 1; curr_size < n; curr_size = 2 * curr_size) {
@@ -113,7 +128,117 @@ void merge_sort_iterative(int arr[], int n) {
             }
         }
     }
-    free(temp);
+}
+
+// Fusion sans branchement de left[0..nl) et right[0..nr) dans out, avec
+// nl <= nr <= nl + 1 (les deux moitiés du tri en ping-pong). Le choix de
+// l'élément devient un cmov. On remplit la sortie par les deux bouts à la
+// fois (« parity merge »): les deux chaînes de dépendances sont
+// indépendantes, et comme chaque bout produit exactement sa moitié de la
+// sortie, aucun pointeur ne peut dépasser sa séquence: pas de test de fin.
+static void merge_branchless(const int left[], const int nl, const int right[], const int nr, int out[]) {
+    // Séquences déjà dans l'ordre (ou dans l'ordre inverse): simple concaténation
+    if (COUNT_COMPARISON(left[nl - 1] <= right[0])) {
+        memcpy(out, left, nl * sizeof(int));
+        memcpy(out + nl, right, nr * sizeof(int));
+        COUNT_SWAPS(nl + nr);
+        return;
+    }
+    if (COUNT_COMPARISON(right[nr - 1] < left[0])) {
+        memcpy(out, right, nr * sizeof(int));
+        memcpy(out + nr, left, nl * sizeof(int));
+        COUNT_SWAPS(nl + nr);
+        return;
+    }
+
+    const int* head_left = left;
+    const int* head_right = right;
+    const int* tail_left = left + nl - 1;
+    const int* tail_right = right + nr - 1;
+    int* head_out = out;
+    int* tail_out = out + nl + nr - 1;
+
+    // Les égalités sortent à gauche par le début et à droite par la fin: stable
+    #define HEAD_STEP() do { \
+            const int take_right_ = COUNT_COMPARISON(*head_right < *head_left); \
+            *head_out++ = take_right_ ? *head_right : *head_left; \
+            head_right += take_right_; \
+            head_left += !take_right_; \
+        } while (0)
+    #define TAIL_STEP() do { \
+            const int take_left_ = COUNT_COMPARISON(*tail_right < *tail_left); \
+            *tail_out-- = take_left_ ? *tail_left : *tail_right; \
+            tail_left -= take_left_; \
+            tail_right -= !take_left_; \
+        } while (0)
+
+    if (nl < nr) HEAD_STEP();
+    HEAD_STEP();
+    for (int k = nl - 1; k > 0; k--) {
+        HEAD_STEP();
+        TAIL_STEP();
+    }
+    TAIL_STEP();
+
+    #undef HEAD_STEP
+    #undef TAIL_STEP
+
+    COUNT_SWAPS(nl + nr);
+}
+
+// Tri par insertion de src[0..n) écrit directement dans dst (src n'est pas modifié)
+static void insertion_sort_into(const int src[], int dst[], const int n) {
+    for (int i = 0; i < n; i++) {
+        const int key = src[i];
+        int j = i - 1;
+
+        while (j >= 0 && COUNT_COMPARISON(dst[j] > key)) {
+            dst[j + 1] = dst[j];
+            COUNT_SWAP();
+            j--;
+        }
+
+        dst[j + 1] = key;
+        COUNT_SWAP();
+    }
+}
+
+// Trie src[0..n) et laisse le résultat dans dst si to_dst, sinon dans src.
+// Les deux moitiés sont triées vers l'autre tableau puis fusionnées vers la
+// cible: les rôles s'alternent à chaque niveau et aucun élément n'est copié
+// en dehors des fusions (et des feuilles, triées directement vers la cible).
+static void pingpong_sort(int src[], int dst[], const int n, const int to_dst) {
+    if (n <= PINGPONG_LEAF) {
+        if (to_dst) {
+            insertion_sort_into(src, dst, n);
+        } else {
+            insertion_sort_iterative(src, n);
+        }
+        return;
+    }
+
+    const int half = n / 2;
+    pingpong_sort(src, dst, half, !to_dst);
+    pingpong_sort(src + half, dst + half, n - half, !to_dst);
+
+    if (to_dst) {
+        merge_branchless(src, half, src + half, n - half, dst);
+    } else {
+        merge_branchless(dst, half, dst + half, n - half, src);
+    }
+}
+
+// Tri Fusion en ping-pong (fusion sans branchement, sans copie avant chaque fusion)
+void merge_sort_pingpong(int arr[], const int n) {
+    merge_sort_pingpong_ws(arr, n, thread_workspace());
+}
+
+// Tri Fusion en ping-pong, second tableau pris dans l'espace de travail ws
+void merge_sort_pingpong_ws(int arr[], const int n, SortWorkspace* ws) {
+    if (n <= 1) return;
+
+    int* temp = workspace_reserve(ws, n);
+    pingpong_sort(arr, temp, n, 0);
 }
 
 // Tri Rapide classique (en utilisant le premier élément comme pivot)
@@ -138,13 +263,12 @@ int partition_classic(int arr[], const int low, const int high) {
     int i = low + 1;
 
     for (int j = low + 1; j <= high; j++) {
-        comparisons++;
-        if (arr[j] < pivot) {
+        if (COUNT_COMPARISON(arr[j] < pivot)) {
             // On permute arr[i] et arr[j]
             const int temp = arr[i];
             arr[i] = arr[j];
             arr[j] = temp;
-            swaps++;
+            COUNT_SWAP();
             i++;
         }
     }
@@ -153,7 +277,7 @@ int partition_classic(int arr[], const int low, const int high) {
     const int temp = arr[low];
     arr[low] = arr[i - 1];
     arr[i - 1] = temp;
-    swaps++;
+    COUNT_SWAP();
 
     return i - 1;
 }
@@ -174,30 +298,30 @@ void quick_sort_median_impl(int arr[], const int low, const int high) {
     }
 }
 
-int partition_median(int arr[], const int low, const int high) {
-    // On trouve la médiane des trois (premier, milieu, dernier) pour le pivot
+// Place en arr[low] la médiane des trois (premier, milieu, dernier)
+static void median_of_three_to_low(int arr[], const int low, const int high) {
     const int mid = low + (high - low) / 2;
 
     // On trie les trois éléments
-    if (++comparisons && arr[mid] < arr[low]) {
+    if (COUNT_COMPARISON(arr[mid] < arr[low])) {
         const int temp = arr[mid];
         arr[mid] = arr[low];
         arr[low] = temp;
-        swaps++;
+        COUNT_SWAP();
     }
 
-    if (++comparisons && arr[high] < arr[low]) {
+    if (COUNT_COMPARISON(arr[high] < arr[low])) {
         const int temp = arr[high];
         arr[high] = arr[low];
         arr[low] = temp;
-        swaps++;
+        COUNT_SWAP();
     }
 
-    if (++comparisons && arr[high] < arr[mid]) {
+    if (COUNT_COMPARISON(arr[high] < arr[mid])) {
         const int temp = arr[high];
         arr[high] = arr[mid];
         arr[mid] = temp;
-        swaps++;
+        COUNT_SWAP();
     }
 
     // La médiane est maintenant au milieu
@@ -205,8 +329,119 @@ int partition_median(int arr[], const int low, const int high) {
     const int temp = arr[low];
     arr[low] = arr[mid];
     arr[mid] = temp;
-    swaps++;
+    COUNT_SWAP();
+}
+
+int partition_median(int arr[], const int low, const int high) {
+    // On trouve la médiane des trois (premier, milieu, dernier) pour le pivot
+    median_of_three_to_low(arr, low, high);
 
     // On utilise la médiane comme le pivot de la partition classique
     return partition_classic(arr, low, high);
-}
\ No newline at end of file
+}
+
+static inline void swap_range(int arr[], int i, int j, int count) {
+    while (count-- > 0) {
+        const int temp = arr[i];
+        arr[i++] = arr[j];
+        arr[j++] = temp;
+        COUNT_SWAP();
+    }
+}
+
+// Partition à trois voies de Bentley et McIlroy, pivot arr[low]. En une
+// passe: arr[low..*lt-1] < pivot, arr[*lt..*gt] == pivot, arr[*gt+1..high] > pivot.
+// Les égaux rencontrés sont d'abord rangés aux deux extrémités, puis ramenés
+// au centre à la fin: sans doublons, le coût est celui d'une partition simple.
+void partition_3way(int arr[], const int low, const int high, int* lt, int* gt) {
+    const int pivot = arr[low];
+    int a = low + 1, b = low + 1;
+    int c = high, d = high;
+
+    while (1) {
+        while (b <= c && COUNT_COMPARISON(arr[b] <= pivot)) {
+            if (COUNT_COMPARISON(arr[b] == pivot)) swap_range(arr, a++, b, 1);
+            b++;
+        }
+        while (b <= c && COUNT_COMPARISON(arr[c] >= pivot)) {
+            if (COUNT_COMPARISON(arr[c] == pivot)) swap_range(arr, c, d--, 1);
+            c--;
+        }
+        if (b > c) break;
+        swap_range(arr, b++, c--, 1);
+    }
+
+    // Égaux de gauche [low, a) et de droite (d, high] ramenés au centre
+    const int left_equal = a - low < b - a ? a - low : b - a;
+    swap_range(arr, low, b - left_equal, left_equal);
+    const int right_equal = d - c < high - d ? d - c : high - d;
+    swap_range(arr, b, high - right_equal + 1, right_equal);
+
+    *lt = low + (b - a);
+    *gt = high - (d - c);
+}
+
+// Tri Rapide à trois voies: les clés égales au pivot sont placées en une
+// passe et jamais revisitées; O(n log k) pour k valeurs distinctes
+void quick_sort_3way(int arr[], const int n) {
+    quick_sort_3way_impl(arr, 0, n - 1);
+}
+
+void quick_sort_3way_impl(int arr[], int low, int high) {
+    while (low < high) {
+        median_of_three_to_low(arr, low, high);
+
+        int lt, gt;
+        partition_3way(arr, low, high, &lt, &gt);
+
+        // Récursion sur le plus petit côté, boucle sur le plus grand
+        if (lt - low < high - gt) {
+            quick_sort_3way_impl(arr, low, lt - 1);
+            low = gt + 1;
+        } else {
+            quick_sort_3way_impl(arr, gt + 1, high);
+            high = lt - 1;
+        }
+    }
+}
+
+// Tamisage vers le bas pour le tas max arr[0..n)
+static void sift_down(int arr[], int root, const int n) {
+    const int value = arr[root];
+
+    while (2 * root + 1 < n) {
+        int child = 2 * root + 1;
+
+        // On prend le plus grand des deux enfants
+        if (child + 1 < n && COUNT_COMPARISON(arr[child] < arr[child + 1])) {
+            child++;
+        }
+        if (!COUNT_COMPARISON(value < arr[child])) {
+            break;
+        }
+
+        arr[root] = arr[child];
+        COUNT_SWAP();
+        root = child;
+    }
+
+    arr[root] = value;
+}
+
+// Tri par tas (sert de garde-fou au tri rapide introspectif)
+void heap_sort(int arr[], const int n) {
+    // Construction du tas max
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        sift_down(arr, i, n);
+    }
+
+    // On place le maximum à la fin et on reconstruit le tas sur le reste
+    for (int end = n - 1; end > 0; end--) {
+        const int temp = arr[0];
+        arr[0] = arr[end];
+        arr[end] = temp;
+        COUNT_SWAP();
+
+        sift_down(arr, 0, end);
+    }
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include "tri_composite.h"
+
+// Réseaux de tri bitoniques pour les feuilles de 8, 16 ou 32 entiers.
+// Les comparateurs sont tous orientés (min à gauche): chaque fusion commence
+// par un étage « miroir » puis des demi-nettoyeurs de distance k/4, ..., 1.
+// Une liste plus courte est complétée par INT_MAX jusqu'à la taille du réseau.
+
+// Nombre de comparateurs d'un réseau bitonique de taille 8, 16 et 32
+#define NETWORK_COMPARATORS_8 24
+#define NETWORK_COMPARATORS_16 80
+#define NETWORK_COMPARATORS_32 240
+
+static int network_size(const int n) {
+    return n <= 8 ? 8 : (n <= 16 ? 16 : 32);
+}
+
+static inline int network_comparators(const int size) {
+    return size == 8 ? NETWORK_COMPARATORS_8 : (size == 16 ? NETWORK_COMPARATORS_16 : NETWORK_COMPARATORS_32);
+}
+
+static inline void compare_exchange(int x[], const int i, const int j) {
+    const int a = x[i];
+    const int b = x[j];
+    x[i] = a < b ? a : b;
+    x[j] = a < b ? b : a;
+}
+
+// Version scalaire (sans branchement: min/max par cmov, vectorisable)
+void sort_network_scalar(int arr[], const int n) {
+    if (n <= 1) return;
+
+    const int size = network_size(n);
+    int x[32];
+    memcpy(x, arr, n * sizeof(int));
+    for (int i = n; i < size; i++) x[i] = INT_MAX;
+
+    for (int k = 2; k <= size; k <<= 1) {
+        // Étage miroir: chaque élément est comparé à son symétrique dans son bloc de taille k
+        for (int block = 0; block < size; block += k) {
+            for (int j = 0; j < k / 2; j++) {
+                compare_exchange(x, block + j, block + k - 1 - j);
+            }
+        }
+
+        // Demi-nettoyeurs
+        for (int d = k / 4; d > 0; d >>= 1) {
+            for (int block = 0; block < size; block += 2 * d) {
+                for (int j = 0; j < d; j++) {
+                    compare_exchange(x, block + j, block + j + d);
+                }
+            }
+        }
+    }
+
+    memcpy(arr, x, n * sizeof(int));
+    COUNT_COMPARISONS(network_comparators(size));
+    COUNT_SWAPS(n);
+}
+
+// Un étage dans un registre: chaque voie est comparée à la voie désignée par
+// la permutation; les voies du masque gardent le max, les autres le min.
+#define NETWORK_STAGE(v, perm, mask) do { \
+        const __m256i shuffled_ = _mm256_permutevar8x32_epi32((v), (perm)); \
+        (v) = _mm256_blend_epi32(_mm256_min_epi32((v), shuffled_), \
+                                 _mm256_max_epi32((v), shuffled_), (mask)); \
+    } while (0)
+
+#define LANES(a, b, c, d, e, f, g, h) _mm256_setr_epi32(a, b, c, d, e, f, g, h)
+
+// Demi-nettoyeurs de distance 4, 2 et 1 à l'intérieur d'un registre
+__attribute__((target("avx2")))
+static inline __m256i clean8(__m256i v) {
+    NETWORK_STAGE(v, LANES(4, 5, 6, 7, 0, 1, 2, 3), 0xF0);
+    NETWORK_STAGE(v, LANES(2, 3, 0, 1, 6, 7, 4, 5), 0xCC);
+    NETWORK_STAGE(v, LANES(1, 0, 3, 2, 5, 4, 7, 6), 0xAA);
+    return v;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sort8(__m256i v) {
+    const __m256i swap_pairs = LANES(1, 0, 3, 2, 5, 4, 7, 6);
+
+    NETWORK_STAGE(v, swap_pairs, 0xAA);
+
+    NETWORK_STAGE(v, LANES(3, 2, 1, 0, 7, 6, 5, 4), 0xCC);
+    NETWORK_STAGE(v, swap_pairs, 0xAA);
+
+    NETWORK_STAGE(v, LANES(7, 6, 5, 4, 3, 2, 1, 0), 0xF0);
+    NETWORK_STAGE(v, LANES(2, 3, 0, 1, 6, 7, 4, 5), 0xCC);
+    NETWORK_STAGE(v, swap_pairs, 0xAA);
+    return v;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i reverse8(const __m256i v) {
+    return _mm256_permutevar8x32_epi32(v, LANES(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Fusionne deux registres triés: *a reçoit les 8 plus petits
+__attribute__((target("avx2")))
+static inline void merge16(__m256i* a, __m256i* b) {
+    const __m256i reversed = reverse8(*b);
+    const __m256i low = _mm256_min_epi32(*a, reversed);
+    const __m256i high = _mm256_max_epi32(*a, reversed);
+    *a = clean8(low);
+    *b = clean8(reverse8(high));
+}
+
+// Fusionne deux paires triées (v0,v1) et (v2,v3)
+__attribute__((target("avx2")))
+static inline void merge32(__m256i v[4]) {
+    // Étage miroir sur 32: v0 <-> v3 inversé, v1 <-> v2 inversé
+    const __m256i r3 = reverse8(v[3]);
+    const __m256i r2 = reverse8(v[2]);
+    const __m256i low0 = _mm256_min_epi32(v[0], r3);
+    const __m256i high0 = _mm256_max_epi32(v[0], r3);
+    const __m256i low1 = _mm256_min_epi32(v[1], r2);
+    const __m256i high1 = _mm256_max_epi32(v[1], r2);
+    v[0] = low0;
+    v[1] = low1;
+    v[2] = reverse8(high1);
+    v[3] = reverse8(high0);
+
+    // Demi-nettoyeur de distance 8 (entre registres)
+    const __m256i min01 = _mm256_min_epi32(v[0], v[1]);
+    const __m256i max01 = _mm256_max_epi32(v[0], v[1]);
+    const __m256i min23 = _mm256_min_epi32(v[2], v[3]);
+    const __m256i max23 = _mm256_max_epi32(v[2], v[3]);
+
+    v[0] = clean8(min01);
+    v[1] = clean8(max01);
+    v[2] = clean8(min23);
+    v[3] = clean8(max23);
+}
+
+// Version AVX2: tout le réseau reste dans les registres ymm
+__attribute__((target("avx2")))
+void sort_network_avx2(int arr[], const int n) {
+    if (n <= 1) return;
+
+    const int size = network_size(n);
+    int x[32] __attribute__((aligned(32)));
+    memcpy(x, arr, n * sizeof(int));
+    for (int i = n; i < size; i++) x[i] = INT_MAX;
+
+    __m256i v[4];
+    for (int r = 0; r < size / 8; r++) {
+        v[r] = sort8(_mm256_load_si256((const __m256i*)(x + 8 * r)));
+    }
+
+    if (size >= 16) {
+        merge16(&v[0], &v[1]);
+    }
+    if (size == 32) {
+        merge16(&v[2], &v[3]);
+        merge32(v);
+    }
+
+    for (int r = 0; r < size / 8; r++) {
+        _mm256_store_si256((__m256i*)(x + 8 * r), v[r]);
+    }
+    memcpy(arr, x, n * sizeof(int));
+
+    COUNT_COMPARISONS(network_comparators(size));
+    COUNT_SWAPS(n);
+}
+
+static void (*network_impl)(int[], int) = NULL;
+static pthread_once_t network_impl_once = PTHREAD_ONCE_INIT;
+
+static void select_network(void) {
+    __builtin_cpu_init();
+    network_impl = __builtin_cpu_supports("avx2") ? sort_network_avx2 : sort_network_scalar;
+}
+
+// Trie au plus SORT_NETWORK_MAX éléments avec le meilleur réseau disponible
+void sort_network(int arr[], const int n) {
+    pthread_once(&network_impl_once, select_network);
+    network_impl(arr, n);
+}
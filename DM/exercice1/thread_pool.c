@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "thread_pool.h"
+
+#define DEQUE_CAPACITY 1024
+
+// File à double entrée d'un thread: le propriétaire empile et dépile en bas
+// (LIFO, bonne localité), les voleurs prennent en haut (les tâches les plus
+// anciennes, donc les plus grosses en fork-join).
+typedef struct {
+    pthread_mutex_t lock;
+    Task* tasks[DEQUE_CAPACITY];
+    int top;
+    int bottom;
+} TaskDeque;
+
+// deques[0..num_workers-1] appartiennent aux workers, deques[num_workers]
+// est la file d'injection partagée par les threads extérieurs au pool.
+static TaskDeque* deques = NULL;
+static pthread_t* workers = NULL;
+static int num_workers = 0;
+
+static atomic_int pool_ready = 0;
+static atomic_int stopping = 0;
+static atomic_int queued = 0;
+static atomic_int sleepers = 0;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_available = PTHREAD_COND_INITIALIZER;
+
+static _Thread_local int worker_id = -1;
+static _Thread_local unsigned int steal_seed = 0;
+
+static int deque_push(TaskDeque* deque, Task* task) {
+    pthread_mutex_lock(&deque->lock);
+    const int full = deque->bottom - deque->top >= DEQUE_CAPACITY;
+    if (!full) {
+        deque->tasks[deque->bottom % DEQUE_CAPACITY] = task;
+        deque->bottom++;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return !full;
+}
+
+static Task* deque_pop(TaskDeque* deque) {
+    Task* task = NULL;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        deque->bottom--;
+        task = deque->tasks[deque->bottom % DEQUE_CAPACITY];
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return task;
+}
+
+static Task* deque_steal(TaskDeque* deque) {
+    Task* task = NULL;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        task = deque->tasks[deque->top % DEQUE_CAPACITY];
+        deque->top++;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return task;
+}
+
+static TaskDeque* own_deque(void) {
+    return worker_id >= 0 ? &deques[worker_id] : &deques[num_workers];
+}
+
+// Cherche une tâche: d'abord la file du thread, puis un vol chez les autres
+static Task* find_task(void) {
+    TaskDeque* own = own_deque();
+    Task* task = deque_pop(own);
+
+    if (task == NULL) {
+        const int num_deques = num_workers + 1;
+        if (steal_seed == 0) steal_seed = (unsigned int)(worker_id + 2) * 2654435761u;
+        steal_seed = steal_seed * 1103515245u + 12345u;
+        const int start = (steal_seed >> 16) % num_deques;
+
+        for (int i = 0; i < num_deques && task == NULL; i++) {
+            TaskDeque* victim = &deques[(start + i) % num_deques];
+            if (victim != own) {
+                task = deque_steal(victim);
+            }
+        }
+    }
+
+    if (task != NULL) {
+        atomic_fetch_sub(&queued, 1);
+    }
+    return task;
+}
+
+static void run_task(Task* task) {
+    task->run(task->arg);
+    atomic_store_explicit(&task->done, 1, memory_order_release);
+}
+
+static void* worker_main(void* arg) {
+    worker_id = (int)(long)arg;
+
+    while (!atomic_load(&stopping)) {
+        Task* task = find_task();
+        if (task != NULL) {
+            run_task(task);
+            continue;
+        }
+
+        // Rien à voler: on dort jusqu'à la prochaine publication
+        pthread_mutex_lock(&pool_lock);
+        atomic_fetch_add(&sleepers, 1);
+        while (atomic_load(&queued) == 0 && !atomic_load(&stopping)) {
+            pthread_cond_wait(&work_available, &pool_lock);
+        }
+        atomic_fetch_sub(&sleepers, 1);
+        pthread_mutex_unlock(&pool_lock);
+    }
+    return NULL;
+}
+
+static void pool_start(int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads < 1) num_threads = 1;
+    }
+
+    num_workers = num_threads - 1;
+    deques = calloc(num_workers + 1, sizeof(TaskDeque));
+    for (int i = 0; i <= num_workers; i++) {
+        pthread_mutex_init(&deques[i].lock, NULL);
+    }
+
+    atomic_store(&stopping, 0);
+    atomic_store(&queued, 0);
+
+    workers = malloc((num_workers > 0 ? num_workers : 1) * sizeof(pthread_t));
+    for (int i = 0; i < num_workers; i++) {
+        if (pthread_create(&workers[i], NULL, worker_main, (void*)(long)i) != 0) {
+            // Les workers déjà créés suffisent: le pool fonctionne avec moins de threads
+            fprintf(stderr, "thread_pool: seulement %d workers sur %d\n", i, num_workers);
+            num_workers = i;
+            break;
+        }
+    }
+
+    atomic_store(&pool_ready, 1);
+}
+
+static void pool_stop(void) {
+    pthread_mutex_lock(&pool_lock);
+    atomic_store(&stopping, 1);
+    pthread_cond_broadcast(&work_available);
+    pthread_mutex_unlock(&pool_lock);
+
+    for (int i = 0; i < num_workers; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    for (int i = 0; i <= num_workers; i++) {
+        pthread_mutex_destroy(&deques[i].lock);
+    }
+    free(deques);
+    free(workers);
+    deques = NULL;
+    workers = NULL;
+    num_workers = 0;
+
+    atomic_store(&pool_ready, 0);
+}
+
+static pthread_mutex_t init_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void ensure_started(void) {
+    if (atomic_load(&pool_ready)) return;
+
+    pthread_mutex_lock(&init_lock);
+    if (!atomic_load(&pool_ready)) {
+        pool_start(0);
+    }
+    pthread_mutex_unlock(&init_lock);
+}
+
+void thread_pool_init(const int num_threads) {
+    pthread_mutex_lock(&init_lock);
+    if (atomic_load(&pool_ready)) {
+        pool_stop();
+    }
+    pool_start(num_threads);
+    pthread_mutex_unlock(&init_lock);
+}
+
+void thread_pool_shutdown(void) {
+    pthread_mutex_lock(&init_lock);
+    if (atomic_load(&pool_ready)) {
+        pool_stop();
+    }
+    pthread_mutex_unlock(&init_lock);
+}
+
+int thread_pool_size(void) {
+    ensure_started();
+    return num_workers + 1;
+}
+
+void task_spawn(Task* task, void (*run)(void* arg), void* arg) {
+    ensure_started();
+
+    task->run = run;
+    task->arg = arg;
+    atomic_store_explicit(&task->done, 0, memory_order_relaxed);
+
+    // Compté avant publication pour qu'un vol immédiat ne rende jamais queued négatif
+    atomic_fetch_add(&queued, 1);
+
+    // File pleine: on exécute la tâche tout de suite
+    if (!deque_push(own_deque(), task)) {
+        atomic_fetch_sub(&queued, 1);
+        run_task(task);
+        return;
+    }
+
+    if (atomic_load(&sleepers) > 0) {
+        pthread_mutex_lock(&pool_lock);
+        pthread_cond_signal(&work_available);
+        pthread_mutex_unlock(&pool_lock);
+    }
+}
+
+void task_wait(Task* task) {
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        Task* other = find_task();
+        if (other != NULL) {
+            run_task(other);
+        } else {
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdatomic.h>
+
+// Tâche fork-join. La structure appartient à celui qui la crée (en général
+// sur sa pile) et doit rester valide jusqu'au retour de task_wait().
+typedef struct {
+    void (*run)(void* arg);
+    void* arg;
+    atomic_int done;
+} Task;
+
+// Démarre le pool avec num_threads threads au total (0 = tous les cœurs).
+// Le thread qui attend une tâche participe au calcul, donc le pool crée
+// num_threads - 1 workers. Un pool déjà démarré est d'abord arrêté.
+void thread_pool_init(int num_threads);
+
+// Arrête les workers. Aucune tâche ne doit être en cours.
+void thread_pool_shutdown(void);
+
+// Nombre de threads du pool (démarre le pool par défaut si nécessaire)
+int thread_pool_size(void);
+
+// Publie une tâche dans la file du thread courant; elle peut être volée par
+// n'importe quel worker inactif.
+void task_spawn(Task* task, void (*run)(void* arg), void* arg);
+
+// Attend la fin d'une tâche en exécutant d'autres tâches en attendant.
+void task_wait(Task* task);
+
+#endif
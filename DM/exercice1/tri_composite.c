@@ -1,20 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include "tri_composite.h"
 
-unsigned long comparisons = 0;
-unsigned long swaps = 0;
-
 int main() {
-    // Initialisation du générateur de nombres aléatoires
-    srand(time(NULL));
-
     const int sizes[TEST_SIZES] = {1000, 2000, 5000, 8000, 10000};
 
     printf("=== Tri Composite - Analyse Pratique ===\n\n");
 
+    // Liste qu'on utilise pour le tri (permettant de ne jamais modifier la liste
+    // source). Allouée une seule fois, à la plus grande taille, pour tous les tests.
+    int* test_array = malloc(sizes[TEST_SIZES - 1] * sizeof(int));
+
     // ---------------------------------------------------
     // Section (a)
     // ---------------------------------------------------
@@ -29,31 +26,60 @@ int main() {
         // La liste inverse correspond (dans la majorité des cas) au pire cas
         int* reverse_array = create_array(size, "reverse");
 
-        // Liste qu'on utilise pour le tri (permettant de ne jamais modifier reverse_array)
-        int* test_array = malloc(size * sizeof(int));
-
         printf("Temps d'exécution pour le cas défavorable (ordre inversé):\n");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, insertion_sort_iterative, "Tri par Insertion (itérative)");
+        measure_time(test_array, size, insertion_sort_iterative, insertion_sort_iterative_uncounted, "Tri par Insertion (itérative)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, insertion_sort_recursive, insertion_sort_recursive_uncounted, "Tri par Insertion (récursive)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, merge_sort_recursive, merge_sort_recursive_uncounted, "Tri Fusion (récursive)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, merge_sort_iterative, merge_sort_iterative_uncounted, "Tri Fusion (itérative)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, merge_sort_pingpong, merge_sort_pingpong_uncounted, "Tri Fusion (ping-pong)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, merge_sort_kway, merge_sort_kway_uncounted, "Tri Fusion (k voies)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, quick_sort_classic, quick_sort_classic_uncounted, "Tri Rapide (classique)");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, insertion_sort_recursive, "Tri par Insertion (récursive)");
+        measure_time(test_array, size, quick_sort_median, quick_sort_median_uncounted, "Tri Rapide (médiane)");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, merge_sort_recursive, "Tri Fusion (récursive)");
+        measure_time(test_array, size, quick_sort_3way, quick_sort_3way_uncounted, "Tri Rapide (3 voies)");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, merge_sort_iterative, "Tri Fusion (itérative)");
+        measure_time(test_array, size, parallel_merge_sort, parallel_merge_sort_uncounted, "Tri Fusion (parallèle)");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, quick_sort_classic, "Tri Rapide (classique)");
+        measure_time(test_array, size, parallel_sample_sort, parallel_sample_sort_uncounted, "Tri par Échantillonnage (parallèle)");
 
         copy_array(reverse_array, test_array, size);
-        measure_time(test_array, size, quick_sort_median, "Tri Rapide (médiane)");
+        measure_time(test_array, size, quick_sort_intro, quick_sort_intro_uncounted, "Tri Rapide (introspectif)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, quick_sort_block, quick_sort_block_uncounted, "Tri Rapide (partition sans branchement)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, radix_sort_lsd, radix_sort_lsd_uncounted, "Tri par Base (LSD)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, radix_sort_msd, radix_sort_msd_uncounted, "Tri par Base (MSD en place)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, adaptive_sort, adaptive_sort_uncounted, "Tri Adaptatif (Powersort)");
+
+        copy_array(reverse_array, test_array, size);
+        measure_time(test_array, size, sort_auto, sort_auto_uncounted, "Tri Automatique (calibré)");
 
         free(reverse_array);
-        free(test_array);
     }
 
     // ---------------------------------------------------
@@ -70,92 +96,140 @@ int main() {
         // Utilisation d'une liste aléatoire (cas moyen)
         int* random_array = create_array(size, "random");
 
-        // Liste qu'on utilise pour le tri (permettant de ne jamais modifier random_array)
-        int* test_array = malloc(size * sizeof(int));
-
         printf("Temps d'exécution pour le cas moyen (ordre aléatoire):\n");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, insertion_sort_iterative, "Tri par Insertion (itérative)");
+        measure_time(test_array, size, insertion_sort_iterative, insertion_sort_iterative_uncounted, "Tri par Insertion (itérative)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, insertion_sort_recursive, insertion_sort_recursive_uncounted, "Tri par Insertion (récursive)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, merge_sort_recursive, merge_sort_recursive_uncounted, "Tri Fusion (récursive)");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, insertion_sort_recursive, "Tri par Insertion (récursive)");
+        measure_time(test_array, size, merge_sort_iterative, merge_sort_iterative_uncounted, "Tri Fusion (itérative)");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, merge_sort_recursive, "Tri Fusion (récursive)");
+        measure_time(test_array, size, merge_sort_pingpong, merge_sort_pingpong_uncounted, "Tri Fusion (ping-pong)");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, merge_sort_iterative, "Tri Fusion (itérative)");
+        measure_time(test_array, size, merge_sort_kway, merge_sort_kway_uncounted, "Tri Fusion (k voies)");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, quick_sort_classic, "Tri Rapide (classique)");
+        measure_time(test_array, size, quick_sort_classic, quick_sort_classic_uncounted, "Tri Rapide (classique)");
 
         copy_array(random_array, test_array, size);
-        measure_time(test_array, size, quick_sort_median, "Tri Rapide (médiane)");
+        measure_time(test_array, size, quick_sort_median, quick_sort_median_uncounted, "Tri Rapide (médiane)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, quick_sort_3way, quick_sort_3way_uncounted, "Tri Rapide (3 voies)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, parallel_merge_sort, parallel_merge_sort_uncounted, "Tri Fusion (parallèle)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, parallel_sample_sort, parallel_sample_sort_uncounted, "Tri par Échantillonnage (parallèle)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, quick_sort_intro, quick_sort_intro_uncounted, "Tri Rapide (introspectif)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, quick_sort_block, quick_sort_block_uncounted, "Tri Rapide (partition sans branchement)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, radix_sort_lsd, radix_sort_lsd_uncounted, "Tri par Base (LSD)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, radix_sort_msd, radix_sort_msd_uncounted, "Tri par Base (MSD en place)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, adaptive_sort, adaptive_sort_uncounted, "Tri Adaptatif (Powersort)");
+
+        copy_array(random_array, test_array, size);
+        measure_time(test_array, size, sort_auto, sort_auto_uncounted, "Tri Automatique (calibré)");
 
         free(random_array);
-        free(test_array);
     }
 
+    free(test_array);
+
     // ---------------------------------------------------
     // Section (c)
     // ---------------------------------------------------
     printf("\n\n3. Comparaison du nombre d'opérations:\n");
     printf("--------------------------------------------------\n");
 
-    char* array_types[] = {"sorted", "nearly_sorted", "reverse", "random"};
-    const int num_types = 4;
-
-    // Matrice de stockage pour les comparaisons et les permutations
-    unsigned long comparison_counts[num_types][NUM_ALGORITHMS];
-    unsigned long swap_counts[num_types][NUM_ALGORITHMS];
+    char* array_types[] = {"sorted", "nearly_sorted", "reverse", "random", "few_unique"};
+    const int num_types = 5;
 
     // Function de pointeurs pour tous les algorithmes
     void (*sort_functions[NUM_ALGORITHMS])(int[], int) = {
         insertion_sort_iterative,
         insertion_sort_recursive,
         merge_sort_recursive,
+        merge_sort_pingpong,
+        merge_sort_kway,
         quick_sort_classic,
-        quick_sort_median
+        quick_sort_median,
+        quick_sort_3way,
+        parallel_merge_sort,
+        parallel_sample_sort,
+        quick_sort_intro,
+        quick_sort_block,
+        radix_sort_lsd,
+        radix_sort_msd,
+        adaptive_sort,
+        sort_auto
     };
 
     char* algorithm_names[NUM_ALGORITHMS] = {
         "Insértion (iter)",
         "Insértion (rec)",
         "Tri Fusion",
+        "Fusion (ping-pong)",
+        "Fusion (k voies)",
         "Tri Rapide",
-        "Tri Rapide (médiane)"
+        "Tri Rapide (médiane)",
+        "Rapide (3 voies)",
+        "Fusion (parallèle)",
+        "Échantillonnage",
+        "Rapide (intro)",
+        "Rapide (blocs)",
+        "Base (LSD)",
+        "Base (MSD)",
+        "Adaptatif",
+        "Automatique"
     };
 
-    // Pour chaque type de liste (array_types)
+    const int test_size = 1000;
+
+    // Les listes sont générées une fois ici, puis partagées en lecture par les tâches
+    int* test_arrays[num_types];
     for (int t = 0; t < num_types; t++) {
-        const int test_size = 1000;
+        test_arrays[t] = create_array(test_size, array_types[t]);
+    }
 
+    // Matrice de stockage pour les comparaisons et les permutations,
+    // remplie en parallèle (une paire type x algorithme par tâche)
+    SortStats operation_counts[num_types * NUM_ALGORITHMS];
+    compute_stats_matrix(test_arrays, num_types, test_size,
+                         sort_functions, NUM_ALGORITHMS, operation_counts);
+
+    // Pour chaque type de liste (array_types)
+    for (int t = 0; t < num_types; t++) {
         printf("\nType de données: %s\n", array_types[t]);
         printf("--------------------------------------------------\n");
         printf("%-20s %15s %15s\n", "Algorithme", "Comparaisons", "Permutations");
         printf("--------------------------------------------------\n");
 
-        int* test_array = create_array(test_size, array_types[t]);
-        int* temp_array = malloc(test_size * sizeof(int));
-
         // Pour chaque algorithme de tri
         for (int a = 0; a < NUM_ALGORITHMS; a++) {
-            reset_counters();
-
-            // On copie la liste et elle se fait trier
-            copy_array(test_array, temp_array, test_size);
-            sort_functions[a](temp_array, test_size);
-
-            // On enregistre les comparaisons et permutations
-            comparison_counts[t][a] = comparisons;
-            swap_counts[t][a] = swaps;
-
-            printf("%-20s %15lu %15lu\n", algorithm_names[a], comparisons, swaps);
+            const SortStats* stats = &operation_counts[t * NUM_ALGORITHMS + a];
+            printf("%-20s %15lu %15lu\n", algorithm_names[a], stats->comparisons, stats->swaps);
         }
 
-        free(test_array);
-        free(temp_array);
+        free(test_arrays[t]);
     }
 
     printf("\n=== Fin de l'Analyse Pratique ===\n");
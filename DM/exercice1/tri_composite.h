@@ -1,17 +1,132 @@
 #ifndef TRI_COMPOSITE_H
 #define TRI_COMPOSITE_H
 
+#include <stddef.h>
+
 #define TEST_SIZES 5
-#define NUM_ALGORITHMS 5
+#define NUM_ALGORITHMS 16
+
+// Compteurs d'opérations, propres à chaque thread: deux tris lancés en
+// parallèle ne mélangent jamais leurs résultats.
+extern _Thread_local unsigned long comparisons;
+extern _Thread_local unsigned long swaps;
+
+// Résultat des compteurs pour un appel de tri
+typedef struct {
+    unsigned long comparisons;
+    unsigned long swaps;
+} SortStats;
+
+// Espace de travail réutilisable (workspace.c). Les noyaux qui ont besoin
+// d'un tampon auxiliaire le prennent ici au lieu de faire malloc/free à
+// chaque appel. Un espace ne sert qu'à un tri à la fois.
+typedef struct {
+    void* data;
+    size_t capacity;
+    int allocations;
+} SortWorkspace;
+
+#define SORT_WORKSPACE_INIT {NULL, 0, 0}
+
+void workspace_init(SortWorkspace* ws);
+void* workspace_reserve_bytes(SortWorkspace* ws, size_t bytes);
+int* workspace_reserve(SortWorkspace* ws, int n);
+void workspace_release(SortWorkspace* ws);
+SortWorkspace* thread_workspace(void);
+
+// Instrumentation des noyaux de tri.
+// Compilé avec -DSORT_UNCOUNTED (cible `make bench_tri`), les compteurs
+// disparaissent des boucles internes et chaque noyau reçoit le suffixe
+// _uncounted, ce qui permet de lier les deux versions dans le même programme.
+#ifdef SORT_UNCOUNTED
+#define COUNT_COMPARISON(cond) (cond)
+#define COUNT_SWAP() ((void)0)
+#define COUNT_SWAPS(k) ((void)0)
+#define COUNT_COMPARISONS(k) ((void)0)
 
-extern unsigned long comparisons;
-extern unsigned long swaps;
+#define insertion_sort_iterative insertion_sort_iterative_uncounted
+#define insertion_sort_recursive insertion_sort_recursive_uncounted
+#define merge_sort_recursive merge_sort_recursive_uncounted
+#define merge_sort_recursive_impl merge_sort_recursive_impl_uncounted
+#define merge_sort_iterative merge_sort_iterative_uncounted
+#define merge_sort_recursive_ws merge_sort_recursive_ws_uncounted
+#define merge_sort_iterative_ws merge_sort_iterative_ws_uncounted
+#define merge_sort_pingpong merge_sort_pingpong_uncounted
+#define merge_sort_pingpong_ws merge_sort_pingpong_ws_uncounted
+#define merge merge_uncounted
+#define loser_tree_init loser_tree_init_uncounted
+#define loser_tree_free loser_tree_free_uncounted
+#define loser_tree_build loser_tree_build_uncounted
+#define loser_tree_replay loser_tree_replay_uncounted
+#define kway_merge kway_merge_uncounted
+#define merge_sort_kway merge_sort_kway_uncounted
+#define merge_sort_kway_ws merge_sort_kway_ws_uncounted
+#define quick_sort_classic quick_sort_classic_uncounted
+#define quick_sort_classic_impl quick_sort_classic_impl_uncounted
+#define partition_classic partition_classic_uncounted
+#define quick_sort_median quick_sort_median_uncounted
+#define quick_sort_median_impl quick_sort_median_impl_uncounted
+#define quick_sort_3way quick_sort_3way_uncounted
+#define quick_sort_3way_impl quick_sort_3way_impl_uncounted
+#define partition_3way partition_3way_uncounted
+#define partition_median partition_median_uncounted
+#define heap_sort heap_sort_uncounted
+#define partition_block partition_block_uncounted
+#define partition_avx2 partition_avx2_uncounted
+#define partition_fast partition_fast_uncounted
+#define quick_sort_block quick_sort_block_uncounted
+#define sort_network sort_network_uncounted
+#define sort_network_scalar sort_network_scalar_uncounted
+#define sort_network_avx2 sort_network_avx2_uncounted
+#define radix_sort_lsd radix_sort_lsd_uncounted
+#define radix_sort_lsd11 radix_sort_lsd11_uncounted
+#define radix_sort_msd radix_sort_msd_uncounted
+#define radix_sort_lsd_ws radix_sort_lsd_ws_uncounted
+#define radix_sort_lsd11_ws radix_sort_lsd11_ws_uncounted
+#define adaptive_sort adaptive_sort_uncounted
+#define adaptive_sort_ws adaptive_sort_ws_uncounted
+#define parallel_merge_sort parallel_merge_sort_uncounted
+#define parallel_merge_sort_ws parallel_merge_sort_ws_uncounted
+#define parallel_sample_sort parallel_sample_sort_uncounted
+#define parallel_sample_sort_ws parallel_sample_sort_ws_uncounted
+#define quick_sort_intro quick_sort_intro_uncounted
+#define segmented_sort segmented_sort_uncounted
+#define argsort argsort_uncounted
+#define argsort_ws argsort_ws_uncounted
+#define apply_permutation apply_permutation_uncounted
+#define apply_permutation_ws apply_permutation_ws_uncounted
+#define apply_permutation_cycles apply_permutation_cycles_uncounted
+#define apply_permutation_cycles_ws apply_permutation_cycles_ws_uncounted
+#define nth_element nth_element_uncounted
+#define partial_sort partial_sort_uncounted
+#define topk_init topk_init_uncounted
+#define topk_push topk_push_uncounted
+#define topk_result topk_result_uncounted
+#define topk_free topk_free_uncounted
+#define incremental_sort_init incremental_sort_init_uncounted
+#define incremental_sort_next_batch incremental_sort_next_batch_uncounted
+#define incremental_sort_next incremental_sort_next_uncounted
+#define incremental_sort_free incremental_sort_free_uncounted
+#define sort_auto sort_auto_uncounted
+#define sort_auto_profile sort_auto_profile_uncounted
+#define sort_auto_choice sort_auto_choice_uncounted
+#define sort_auto_calibrate sort_auto_calibrate_uncounted
+#else
+#define COUNT_COMPARISON(cond) (++comparisons, (cond))
+#define COUNT_SWAP() (swaps++)
+#define COUNT_SWAPS(k) (swaps += (k))
+#define COUNT_COMPARISONS(k) (comparisons += (k))
+#endif
 
 void insertion_sort_iterative(int arr[], int n);
 void insertion_sort_recursive(int arr[], int n);
 void merge_sort_recursive(int arr[], int n);
 void merge_sort_recursive_impl(int arr[], int temp[], int left, int right);
 void merge_sort_iterative(int arr[], int n);
+void merge_sort_recursive_ws(int arr[], int n, SortWorkspace* ws);
+void merge_sort_iterative_ws(int arr[], int n, SortWorkspace* ws);
+void merge_sort_pingpong(int arr[], int n);
+void merge_sort_pingpong_ws(int arr[], int n, SortWorkspace* ws);
 void merge(int arr[], int temp[], int left, int mid, int right);
 void quick_sort_classic(int arr[], int n);
 void quick_sort_classic_impl(int arr[], int low, int high);
@@ -19,12 +134,260 @@ int partition_classic(int arr[], int low, int high);
 void quick_sort_median(int arr[], int n);
 void quick_sort_median_impl(int arr[], int low, int high);
 int partition_median(int arr[], int low, int high);
+void quick_sort_3way(int arr[], int n);
+void quick_sort_3way_impl(int arr[], int low, int high);
+void partition_3way(int arr[], int low, int high, int* lt, int* gt);
+void heap_sort(int arr[], int n);
+
+// Fusion à k voies par arbre des perdants (kway_merge.c).
+// Chaque entrée de l'arbre réunit la tête d'une source et son numéro
+// ((clé << 32) | source): une seule comparaison d'entiers 64 bits ordonne
+// deux sources, égalités départagées par le numéro (fusion stable). Les
+// noeuds 1..k-1 gardent le perdant de leur match, tree[0] le vainqueur.
+// Après avoir consommé la tête du vainqueur, on rejoue son chemin avec la
+// tête suivante de la même source (ou LOSER_TREE_DONE si elle est épuisée):
+// log2(k) comparaisons par élément, sans branchement.
+#define LOSER_TREE_DONE 0x7FFFFFFFFFFFFFFFLL
+#define LOSER_TREE_ENTRY(key, source) ((long long)(key) * 4294967296LL + (source))
+#define LOSER_TREE_KEY(entry) ((int)((entry) >> 32))
+#define LOSER_TREE_SOURCE(entry) ((int)((entry) & 0xFFFFFFFF))
+
+typedef struct {
+    int k;
+    long long* tree;
+} LoserTree;
+
+void loser_tree_init(LoserTree* lt, int k);
+void loser_tree_free(LoserTree* lt);
+// entries[s]: entrée initiale de la source s
+void loser_tree_build(LoserTree* lt, const long long entries[]);
+// Remplace l'entrée du vainqueur actuel par `entry` (même source)
+void loser_tree_replay(LoserTree* lt, long long entry);
+
+// Fusionne k séquences triées (spans[s][0..lengths[s])) dans out, de façon
+// stable: à égalité, la séquence d'indice le plus petit passe en premier
+void kway_merge(const int* spans[], const int lengths[], int k, int out[]);
+void merge_sort_kway(int arr[], int n);
+void merge_sort_kway_ws(int arr[], int n, SortWorkspace* ws);
+
+// Moteur de partition sans branchement (partition.c)
+int partition_block(int arr[], int low, int high);
+int partition_avx2(int arr[], int low, int high);
+int partition_fast(int arr[], int low, int high);
+const char* partition_fast_name(void);
+void quick_sort_block(int arr[], int n);
+
+// Réseaux de tri pour les feuilles des tris récursifs (sorting_network.c)
+#define SORT_NETWORK_MAX 32
+void sort_network(int arr[], int n);
+void sort_network_scalar(int arr[], int n);
+void sort_network_avx2(int arr[], int n);
+
+// Tris par base sur les clés entières 32 bits (radix_sort.c)
+void radix_sort_lsd(int arr[], int n);
+void radix_sort_lsd11(int arr[], int n);
+void radix_sort_msd(int arr[], int n);
+void radix_sort_lsd_ws(int arr[], int n, SortWorkspace* ws);
+void radix_sort_lsd11_ws(int arr[], int n, SortWorkspace* ws);
+
+// Tri adaptatif par séquences naturelles, Powersort (adaptive_sort.c)
+void adaptive_sort(int arr[], int n);
+void adaptive_sort_ws(int arr[], int n, SortWorkspace* ws);
+
+// Tris parallèles (parallel_sort.c, pool de threads de thread_pool.c)
+#define PARALLEL_MERGE_DEFAULT_CUTOFF 8192
+#define PARALLEL_QUICK_DEFAULT_CUTOFF 16384
+extern int parallel_merge_cutoff;
+extern int parallel_quick_cutoff;
+void parallel_merge_sort(int arr[], int n);
+void parallel_merge_sort_ws(int arr[], int n, SortWorkspace* ws);
+void parallel_sample_sort(int arr[], int n);
+void parallel_sample_sort_ws(int arr[], int n, SortWorkspace* ws);
+void quick_sort_intro(int arr[], int n);
+
+// Tri segmenté: beaucoup de petites listes dans un seul tampon, le segment s
+// étant data[offsets[s]..offsets[s+1]). Aucune allocation; classes de
+// taille (réseau de tri, quick_sort_block) et tranches réparties sur le pool.
+void segmented_sort(int data[], const int offsets[], int num_segments);
+
+// Tri indirect (argsort.c): perm reçoit la permutation stable qui trie keys
+// (keys[perm[0]] <= keys[perm[1]] <= ..., indices croissants à clé égale),
+// par un tri par base sur des paires (clé, indice) de 64 bits. La
+// permutation s'applique ensuite à des colonnes de n'importe quel type:
+// columns[c][i] reçoit l'ancien columns[c][perm[i]].
+void argsort(const int keys[], int n, int perm[]);
+void argsort_ws(const int keys[], int n, int perm[], SortWorkspace* ws);
+void apply_permutation(const int perm[], int n, void* columns[], const size_t element_sizes[], int num_columns);
+void apply_permutation_ws(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                          int num_columns, SortWorkspace* ws);
+void apply_permutation_cycles(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                              int num_columns);
+void apply_permutation_cycles_ws(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                                 int num_columns, SortWorkspace* ws);
+
+// Sélection sans tri complet (selection.c), sur partition_fast et
+// partition_classic: nth_element en O(n) (sélection introspective, médiane
+// des médianes en dernier recours), partial_sort en O(n + k log k).
+void nth_element(int arr[], int n, int k);
+void partial_sort(int arr[], int n, int k);
+
+// Les k plus petites valeurs d'un flux qui ne tient pas en mémoire
+typedef struct {
+    int k;
+    int* buffer;
+    int count;
+    int threshold;
+    int full;
+} TopK;
+
+void topk_init(TopK* topk, int k);
+void topk_push(TopK* topk, const int values[], int n);
+int topk_result(TopK* topk, int out[]);
+void topk_free(TopK* topk);
+
+// Tri incrémental sur partition_median: les éléments sortent dans l'ordre,
+// par lots, et seuls ceux qui sont lus sont triés (O(n) au premier lot,
+// O(k log k) en moyenne pour k éléments lus). arr est trié en place au fur
+// et à mesure. La pile garde des paires (début, fin) de blocs de pivots.
+typedef struct {
+    int* arr;
+    int n;
+    int next;
+    int sorted_end;
+    int fallback;
+    int* stack;
+    int top;
+    int capacity;
+} IncrementalSort;
+
+void incremental_sort_init(IncrementalSort* is, int arr[], int n);
+int incremental_sort_next_batch(IncrementalSort* is, int out[], int k);
+int incremental_sort_next(IncrementalSort* is, int* value);
+void incremental_sort_free(IncrementalSort* is);
+
+// Tri automatique (auto_sort.c): un profil échantillonné de l'entrée (environ
+// 2000 comparaisons) choisit le noyau. Les seuils viennent d'une calibration
+// sur l'hôte (sort_auto_calibrate, suite « auto » de bench_tri), enregistrée
+// dans le fichier SORT_AUTO_CALIBRATION (défaut: sort_auto.cal) et relue au
+// premier appel; sans fichier, des valeurs par défaut.
+typedef struct {
+    // Taille au plus: tri par insertion
+    int insertion_max;
+    // Fins de séquence par paire voisine au plus: adaptive_sort
+    double runs_max;
+    // Inversions par élément au plus (borne haute de l'estimation): tri par insertion
+    double inversions_max;
+    // Paires inversées au plus (ou au moins 1 - nearly_sorted_max):
+    // quick_sort_block plutôt que radix_sort_lsd
+    double nearly_sorted_max;
+    // Voisins égaux dans un échantillon trié au moins: quick_sort_3way
+    double duplicates_min;
+    // Taille au moins: radix_sort_lsd, sinon quick_sort_block
+    int radix_min;
+    // Taille au moins, avec plusieurs threads: parallel_sample_sort
+    int parallel_min;
+} SortAutoThresholds;
+
+typedef struct {
+    int n;
+    double run_ratio;
+    double inversion_ratio;
+    double duplicate_ratio;
+} SortAutoProfile;
+
+void sort_auto(int arr[], int n);
+void sort_auto_profile(const int arr[], int n, SortAutoProfile* profile);
+const char* sort_auto_choice(const SortAutoProfile* profile);
+void sort_auto_get_thresholds(SortAutoThresholds* thresholds);
+void sort_auto_set_thresholds(const SortAutoThresholds* thresholds);
+const char* sort_auto_calibration_path(void);
+int sort_auto_save(const char* path, const SortAutoThresholds* thresholds);
+int sort_auto_load(const char* path, SortAutoThresholds* thresholds);
+
+// Copies sans compteurs (sorting_algorithms_uncounted.o)
+void insertion_sort_iterative_uncounted(int arr[], int n);
+void insertion_sort_recursive_uncounted(int arr[], int n);
+void merge_sort_recursive_uncounted(int arr[], int n);
+void merge_sort_iterative_uncounted(int arr[], int n);
+void merge_sort_recursive_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void merge_sort_iterative_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void merge_sort_pingpong_uncounted(int arr[], int n);
+void merge_sort_pingpong_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void loser_tree_init_uncounted(LoserTree* lt, int k);
+void loser_tree_free_uncounted(LoserTree* lt);
+void loser_tree_build_uncounted(LoserTree* lt, const long long entries[]);
+void loser_tree_replay_uncounted(LoserTree* lt, long long entry);
+void kway_merge_uncounted(const int* spans[], const int lengths[], int k, int out[]);
+void merge_sort_kway_uncounted(int arr[], int n);
+void merge_sort_kway_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void quick_sort_classic_uncounted(int arr[], int n);
+void quick_sort_median_uncounted(int arr[], int n);
+void quick_sort_3way_uncounted(int arr[], int n);
+void heap_sort_uncounted(int arr[], int n);
+int partition_classic_uncounted(int arr[], int low, int high);
+int partition_median_uncounted(int arr[], int low, int high);
+void partition_3way_uncounted(int arr[], int low, int high, int* lt, int* gt);
+int partition_block_uncounted(int arr[], int low, int high);
+int partition_avx2_uncounted(int arr[], int low, int high);
+int partition_fast_uncounted(int arr[], int low, int high);
+void quick_sort_block_uncounted(int arr[], int n);
+void sort_network_uncounted(int arr[], int n);
+void sort_network_scalar_uncounted(int arr[], int n);
+void sort_network_avx2_uncounted(int arr[], int n);
+void radix_sort_lsd_uncounted(int arr[], int n);
+void radix_sort_lsd11_uncounted(int arr[], int n);
+void radix_sort_msd_uncounted(int arr[], int n);
+void radix_sort_lsd_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void radix_sort_lsd11_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void adaptive_sort_uncounted(int arr[], int n);
+void adaptive_sort_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void parallel_merge_sort_uncounted(int arr[], int n);
+void parallel_merge_sort_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void parallel_sample_sort_uncounted(int arr[], int n);
+void parallel_sample_sort_ws_uncounted(int arr[], int n, SortWorkspace* ws);
+void quick_sort_intro_uncounted(int arr[], int n);
+void segmented_sort_uncounted(int data[], const int offsets[], int num_segments);
+void argsort_uncounted(const int keys[], int n, int perm[]);
+void argsort_ws_uncounted(const int keys[], int n, int perm[], SortWorkspace* ws);
+void apply_permutation_uncounted(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                                 int num_columns);
+void apply_permutation_ws_uncounted(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                                    int num_columns, SortWorkspace* ws);
+void apply_permutation_cycles_uncounted(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                                        int num_columns);
+void apply_permutation_cycles_ws_uncounted(const int perm[], int n, void* columns[], const size_t element_sizes[],
+                                           int num_columns, SortWorkspace* ws);
+void nth_element_uncounted(int arr[], int n, int k);
+void partial_sort_uncounted(int arr[], int n, int k);
+void topk_init_uncounted(TopK* topk, int k);
+void topk_push_uncounted(TopK* topk, const int values[], int n);
+int topk_result_uncounted(TopK* topk, int out[]);
+void topk_free_uncounted(TopK* topk);
+void incremental_sort_init_uncounted(IncrementalSort* is, int arr[], int n);
+int incremental_sort_next_batch_uncounted(IncrementalSort* is, int out[], int k);
+int incremental_sort_next_uncounted(IncrementalSort* is, int* value);
+void incremental_sort_free_uncounted(IncrementalSort* is);
+void sort_auto_uncounted(int arr[], int n);
+void sort_auto_profile_uncounted(const int arr[], int n, SortAutoProfile* profile);
+const char* sort_auto_choice_uncounted(const SortAutoProfile* profile);
+// Mesure les noyaux sans compteurs: n'existe que dans auto_sort_uncounted.o
+void sort_auto_calibrate_uncounted(SortAutoThresholds* thresholds);
 
 void reset_counters();
+void read_counters(SortStats* stats);
+void merge_counters(const SortStats* stats);
+void sort_with_stats(int arr[], int n, void (*sort_function)(int[], int), SortStats* stats);
+void compute_stats_matrix(int* inputs[], int num_inputs, int size,
+                          void (*sort_functions[])(int[], int), int num_algorithms,
+                          SortStats results[]);
 void print_array(int arr[], int size);
 void copy_array(int src[], int dest[], int size);
 int* create_array(int size, char* type);
-void measure_time(int array[], int size, void (*sort_function)(int[], int), char* sort_name);
+int is_sorted(int arr[], int size);
+double time_sort(int array[], int size, void (*sort_function)(int[], int));
+double wall_time_sort(int array[], int size, void (*sort_function)(int[], int));
+void measure_time(int array[], int size, void (*sort_function)(int[], int),
+                  void (*uncounted_function)(int[], int), char* sort_name);
 void shuffle_array(int arr[], int n);
 
 #endif
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "external_sort.h"
+#include "tri_composite.h"
+#include "benchmark.h"
+#include "generator.h"
+
+// Budget mémoire par défaut, en Mo
+#define DEFAULT_MEMORY_MB 256
+
+// Entiers générés ou vérifiés par bloc (le fichier n'est jamais chargé en entier)
+#define STREAM_BLOCK (1 << 20)
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s entree sortie [memoire_Mo]   trie un fichier d'entiers 32 bits (défaut %d Mo)\n"
+            "  %s --generer fichier n          écrit n entiers aléatoires (graine: BENCH_SEED)\n"
+            "  %s --verifier fichier           vérifie que le fichier est trié\n"
+            "  %s --plus-petits fichier k      affiche les k plus petits entiers, triés\n",
+            prog, DEFAULT_MEMORY_MB, prog, prog, prog);
+}
+
+static int generate_file(const char* path, const long n) {
+    FILE* out = fopen(path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", path);
+        return 1;
+    }
+
+    Rng rng;
+    rng_seed(&rng, generator_default_seed());
+    int* block = malloc(STREAM_BLOCK * sizeof(int));
+
+    for (long written = 0; written < n; written += STREAM_BLOCK) {
+        const long count = n - written < STREAM_BLOCK ? n - written : STREAM_BLOCK;
+        for (long i = 0; i < count; i++) {
+            block[i] = (int)rng_next(&rng);
+        }
+        if (fwrite(block, sizeof(int), count, out) != (size_t)count) {
+            fprintf(stderr, "Erreur d'écriture de %s\n", path);
+            free(block);
+            fclose(out);
+            return 1;
+        }
+    }
+
+    free(block);
+    fclose(out);
+    printf("%ld entiers écrits dans %s\n", n, path);
+    return 0;
+}
+
+static int verify_file(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", path);
+        return 1;
+    }
+
+    int* block = malloc(STREAM_BLOCK * sizeof(int));
+    long total = 0;
+    int previous = 0;
+    int sorted = 1;
+    size_t count;
+
+    while (sorted && (count = fread(block, sizeof(int), STREAM_BLOCK, in)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            if (total + (long)i > 0 && block[i] < previous) {
+                sorted = 0;
+                total += i;
+                break;
+            }
+            previous = block[i];
+        }
+        if (sorted) total += count;
+    }
+
+    free(block);
+    fclose(in);
+
+    if (!sorted) {
+        printf("%s n'est pas trié (élément %ld)\n", path, total);
+        return 1;
+    }
+    printf("%s est trié (%ld entiers)\n", path, total);
+    return 0;
+}
+
+// Sélection en flux: le fichier est lu par blocs, seuls 2k entiers restent
+// en mémoire
+static int smallest_in_file(const char* path, const int k) {
+    FILE* in = fopen(path, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", path);
+        return 1;
+    }
+
+    const double start = bench_wall_time();
+    int* block = malloc(STREAM_BLOCK * sizeof(int));
+    TopK topk;
+    topk_init_uncounted(&topk, k);
+    long total = 0;
+    size_t count;
+
+    while ((count = fread(block, sizeof(int), STREAM_BLOCK, in)) > 0) {
+        topk_push_uncounted(&topk, block, count);
+        total += count;
+    }
+    fclose(in);
+
+    const int found = topk_result_uncounted(&topk, block);
+    const double elapsed = bench_wall_time() - start;
+    for (int i = 0; i < found; i++) {
+        printf("%d\n", block[i]);
+    }
+    fprintf(stderr, "%d plus petits de %ld entiers en %.3f secondes\n", found, total, elapsed);
+
+    topk_free_uncounted(&topk);
+    free(block);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--generer") == 0) {
+        return generate_file(argv[2], atol(argv[3]));
+    }
+    if (argc == 3 && strcmp(argv[1], "--verifier") == 0) {
+        return verify_file(argv[2]);
+    }
+    if (argc == 4 && strcmp(argv[1], "--plus-petits") == 0) {
+        const int k = atoi(argv[3]);
+        if (k <= 0 || k > STREAM_BLOCK) {
+            fprintf(stderr, "k invalide: %s (entre 1 et %d)\n", argv[3], STREAM_BLOCK);
+            return 1;
+        }
+        return smallest_in_file(argv[2], k);
+    }
+    if (argc < 3 || argc > 4 || argv[1][0] == '-') {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const long memory_mb = argc > 3 ? atol(argv[3]) : DEFAULT_MEMORY_MB;
+    if (memory_mb <= 0) {
+        fprintf(stderr, "Budget mémoire invalide: %s\n", argv[3]);
+        return 1;
+    }
+
+    ExternalSortConfig config = {(size_t)memory_mb << 20, NULL, NULL};
+    ExternalSortStats stats;
+
+    const double start = bench_wall_time();
+    if (external_sort_file(argv[1], argv[2], &config, &stats) != 0) return 1;
+    const double elapsed = bench_wall_time() - start;
+
+    printf("%ld entiers triés en %.3f secondes (%.1f Mo/s)\n", stats.elements, elapsed,
+           stats.elements * sizeof(int) / elapsed / 1e6);
+    if (stats.in_memory) {
+        printf("Tri en mémoire (fichier projeté)\n");
+    } else {
+        printf("%ld séquences, %d passe(s) de fusion\n", stats.runs, stats.merge_passes);
+    }
+    return 0;
+}
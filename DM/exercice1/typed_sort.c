@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "typed_sort.h"
+
+// Intervalles triés par insertion dans le tri introspectif
+#define TYPED_INSERTION_CUTOFF 16
+#define TYPED_NINTHER_THRESHOLD 128
+
+// Feuilles du tri fusion en ping-pong
+#define TYPED_MERGE_LEAF 16
+
+// En dessous, le tri par base (8 histogrammes de 256 seaux) ne vaut pas l'insertion
+#define TYPED_RADIX_CUTOFF 64
+
+// Clés non signées qui respectent l'ordre des types signés et flottants.
+// Pour les flottants: on inverse le bit de signe des positifs et tous les
+// bits des négatifs; les NaN reçoivent la plus grande clé.
+static inline uint32_t float_key(const float x) {
+    if (isnan(x)) return UINT32_MAX;
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits ^ ((uint32_t)-(int32_t)(bits >> 31) | 0x80000000u);
+}
+
+static inline uint64_t double_key(const double x) {
+    if (isnan(x)) return UINT64_MAX;
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits ^ ((uint64_t)-(int64_t)(bits >> 63) | 0x8000000000000000ull);
+}
+
+// Ordre des flottants: les NaN après tous les nombres (ordre strict faible)
+#define FLOAT_LESS(a, b) ((a) < (b) || (isnan(b) && !isnan(a)))
+
+#define SORT_SUFFIX int32
+#define SORT_TYPE int32_t
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_KEY_TYPE uint32_t
+#define SORT_KEY(x) ((uint32_t)(x) ^ 0x80000000u)
+#include "typed_sort_template.h"
+
+#define SORT_SUFFIX int64
+#define SORT_TYPE int64_t
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_KEY_TYPE uint64_t
+#define SORT_KEY(x) ((uint64_t)(x) ^ 0x8000000000000000ull)
+#include "typed_sort_template.h"
+
+#define SORT_SUFFIX uint32
+#define SORT_TYPE uint32_t
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_KEY_TYPE uint32_t
+#define SORT_KEY(x) (x)
+#include "typed_sort_template.h"
+
+#define SORT_SUFFIX float
+#define SORT_TYPE float
+#define SORT_LESS(a, b) FLOAT_LESS(a, b)
+#define SORT_KEY_TYPE uint32_t
+#define SORT_KEY(x) float_key(x)
+#include "typed_sort_template.h"
+
+#define SORT_SUFFIX double
+#define SORT_TYPE double
+#define SORT_LESS(a, b) FLOAT_LESS(a, b)
+#define SORT_KEY_TYPE uint64_t
+#define SORT_KEY(x) double_key(x)
+#include "typed_sort_template.h"
+
+#define SORT_SUFFIX key_index
+#define SORT_TYPE KeyIndex
+#define SORT_LESS(a, b) ((a).key < (b).key)
+#define SORT_KEY_TYPE uint64_t
+#define SORT_KEY(x) ((uint64_t)(x).key ^ 0x8000000000000000ull)
+#include "typed_sort_template.h"
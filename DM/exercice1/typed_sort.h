@@ -0,0 +1,44 @@
+#ifndef TYPED_SORT_H
+#define TYPED_SORT_H
+
+#include <stdint.h>
+#include "tri_composite.h"
+
+// Tris spécialisés par type d'élément (typed_sort.c). Chaque type reçoit sa
+// propre copie des noyaux, générée à partir de typed_sort_template.h: la
+// comparaison est inlinée, aucun pointeur de fonction sur le chemin critique
+// (contrairement à qsort). Ces noyaux ne sont pas instrumentés.
+//
+// Pour chaque suffixe (int32, int64, uint32, float, double, key_index):
+//   sort_<suffixe>         tri introspectif, non stable, en place
+//   stable_sort_<suffixe>  tri fusion en ping-pong, stable
+//   radix_sort_<suffixe>   tri par base LSD sur la clé, stable
+//   is_sorted_<suffixe>    vérifie l'ordre croissant
+// Les versions _ws prennent leur tampon dans un espace de travail fourni.
+//
+// Flottants: les NaN sont placés après tous les nombres.
+
+// Clé 64 bits avec l'indice de l'élément d'origine (la clé seule est comparée)
+typedef struct {
+    int64_t key;
+    int64_t index;
+} KeyIndex;
+
+#define DECLARE_TYPED_SORT(suffix, type) \
+    void sort_##suffix(type arr[], int n); \
+    void stable_sort_##suffix(type arr[], int n); \
+    void stable_sort_##suffix##_ws(type arr[], int n, SortWorkspace* ws); \
+    void radix_sort_##suffix(type arr[], int n); \
+    void radix_sort_##suffix##_ws(type arr[], int n, SortWorkspace* ws); \
+    int is_sorted_##suffix(const type arr[], int n);
+
+DECLARE_TYPED_SORT(int32, int32_t)
+DECLARE_TYPED_SORT(int64, int64_t)
+DECLARE_TYPED_SORT(uint32, uint32_t)
+DECLARE_TYPED_SORT(float, float)
+DECLARE_TYPED_SORT(double, double)
+DECLARE_TYPED_SORT(key_index, KeyIndex)
+
+#undef DECLARE_TYPED_SORT
+
+#endif
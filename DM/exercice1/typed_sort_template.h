@@ -0,0 +1,271 @@
+// Patron des tris spécialisés par type (inclus plusieurs fois par typed_sort.c,
+// d'où l'absence de garde d'inclusion). Avant chaque inclusion, définir:
+//   SORT_SUFFIX     suffixe des fonctions générées (ex: int32)
+//   SORT_TYPE       type des éléments
+//   SORT_LESS(a, b) ordre strict faible sur deux éléments
+//   SORT_KEY_TYPE   entier non signé (uint32_t ou uint64_t) de la clé de tri par base
+//   SORT_KEY(x)     clé non signée qui respecte SORT_LESS
+// Toutes ces macros sont annulées à la fin du patron.
+
+#define SORT_CONCAT_(a, b) a##_##b
+#define SORT_CONCAT(a, b) SORT_CONCAT_(a, b)
+#define SORT_FN(name) SORT_CONCAT(name, SORT_SUFFIX)
+
+static inline void SORT_FN(swap_elements)(SORT_TYPE* a, SORT_TYPE* b) {
+    const SORT_TYPE temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Tri par insertion (stable), pour les petits intervalles
+static void SORT_FN(insertion_sort)(SORT_TYPE arr[], const int n) {
+    for (int i = 1; i < n; i++) {
+        const SORT_TYPE key = arr[i];
+        int j = i - 1;
+
+        while (j >= 0 && SORT_LESS(key, arr[j])) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+
+        arr[j + 1] = key;
+    }
+}
+
+// Tamisage vers le bas pour le tas max arr[0..n)
+static void SORT_FN(sift_down)(SORT_TYPE arr[], int root, const int n) {
+    const SORT_TYPE value = arr[root];
+
+    while (2 * root + 1 < n) {
+        int child = 2 * root + 1;
+        if (child + 1 < n && SORT_LESS(arr[child], arr[child + 1])) child++;
+        if (!SORT_LESS(value, arr[child])) break;
+
+        arr[root] = arr[child];
+        root = child;
+    }
+
+    arr[root] = value;
+}
+
+static void SORT_FN(heap_sort)(SORT_TYPE arr[], const int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        SORT_FN(sift_down)(arr, i, n);
+    }
+    for (int end = n - 1; end > 0; end--) {
+        SORT_FN(swap_elements)(&arr[0], &arr[end]);
+        SORT_FN(sift_down)(arr, 0, end);
+    }
+}
+
+// Ordonne arr[a] <= arr[b] <= arr[c]
+static inline void SORT_FN(sort_three)(SORT_TYPE arr[], const int a, const int b, const int c) {
+    if (SORT_LESS(arr[b], arr[a])) SORT_FN(swap_elements)(&arr[a], &arr[b]);
+    if (SORT_LESS(arr[c], arr[b])) {
+        SORT_FN(swap_elements)(&arr[b], &arr[c]);
+        if (SORT_LESS(arr[b], arr[a])) SORT_FN(swap_elements)(&arr[a], &arr[b]);
+    }
+}
+
+// Tri Rapide introspectif sur arr[low..high], même schéma que quick_sort_block:
+// pivot aux quartiles (pseudo-médiane de neuf au-delà de TYPED_NINTHER_THRESHOLD),
+// partition de Hoare, récursion sur le plus petit côté, tri par tas au-delà
+// de depth_limit partitions.
+static void SORT_FN(intro_sort)(SORT_TYPE arr[], int low, int high, int depth_limit) {
+    while (high - low + 1 > TYPED_INSERTION_CUTOFF) {
+        if (depth_limit-- == 0) {
+            SORT_FN(heap_sort)(arr + low, high - low + 1);
+            return;
+        }
+
+        const int quarter = (high - low + 1) / 4;
+        const int mid = low + (high - low) / 2;
+        if (high - low + 1 > TYPED_NINTHER_THRESHOLD) {
+            SORT_FN(sort_three)(arr, low + quarter - 1, low + quarter, low + quarter + 1);
+            SORT_FN(sort_three)(arr, mid - 1, mid, mid + 1);
+            SORT_FN(sort_three)(arr, high - quarter - 1, high - quarter, high - quarter + 1);
+        }
+        SORT_FN(sort_three)(arr, low + quarter, mid, high - quarter);
+        SORT_FN(swap_elements)(&arr[low], &arr[mid]);
+
+        // Les éléments égaux au pivot s'arrêtent des deux côtés: les doublons
+        // se répartissent équitablement
+        const SORT_TYPE pivot = arr[low];
+        int i = low + 1;
+        int j = high;
+        while (1) {
+            while (i <= j && SORT_LESS(arr[i], pivot)) i++;
+            while (i <= j && SORT_LESS(pivot, arr[j])) j--;
+            if (i >= j) break;
+            SORT_FN(swap_elements)(&arr[i++], &arr[j--]);
+        }
+        const int p = i - 1;
+        arr[low] = arr[p];
+        arr[p] = pivot;
+
+        if (p - low < high - p) {
+            SORT_FN(intro_sort)(arr, low, p - 1, depth_limit);
+            low = p + 1;
+        } else {
+            SORT_FN(intro_sort)(arr, p + 1, high, depth_limit);
+            high = p - 1;
+        }
+    }
+
+    if (low < high) {
+        SORT_FN(insertion_sort)(arr + low, high - low + 1);
+    }
+}
+
+void SORT_FN(sort)(SORT_TYPE arr[], const int n) {
+    int depth_limit = 0;
+    for (int m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+    SORT_FN(intro_sort)(arr, 0, n - 1, depth_limit);
+}
+
+// Fusion stable de deux moitiés (nl <= nr <= nl + 1) par les deux bouts,
+// comme merge_branchless de sorting_algorithms.c
+static void SORT_FN(merge_halves)(const SORT_TYPE left[], const int nl,
+                                  const SORT_TYPE right[], const int nr, SORT_TYPE out[]) {
+    if (!SORT_LESS(right[0], left[nl - 1])) {
+        memcpy(out, left, nl * sizeof(SORT_TYPE));
+        memcpy(out + nl, right, nr * sizeof(SORT_TYPE));
+        return;
+    }
+
+    const SORT_TYPE* head_left = left;
+    const SORT_TYPE* head_right = right;
+    const SORT_TYPE* tail_left = left + nl - 1;
+    const SORT_TYPE* tail_right = right + nr - 1;
+    SORT_TYPE* head_out = out;
+    SORT_TYPE* tail_out = out + nl + nr - 1;
+
+    #define HEAD_STEP() do { \
+            const int take_right_ = SORT_LESS(*head_right, *head_left); \
+            *head_out++ = take_right_ ? *head_right : *head_left; \
+            head_right += take_right_; \
+            head_left += !take_right_; \
+        } while (0)
+    #define TAIL_STEP() do { \
+            const int take_left_ = SORT_LESS(*tail_right, *tail_left); \
+            *tail_out-- = take_left_ ? *tail_left : *tail_right; \
+            tail_left -= take_left_; \
+            tail_right -= !take_left_; \
+        } while (0)
+
+    if (nl < nr) HEAD_STEP();
+    HEAD_STEP();
+    for (int k = nl - 1; k > 0; k--) {
+        HEAD_STEP();
+        TAIL_STEP();
+    }
+    TAIL_STEP();
+
+    #undef HEAD_STEP
+    #undef TAIL_STEP
+}
+
+// Tri fusion en ping-pong: le résultat est dans dst si to_dst, sinon dans src
+static void SORT_FN(pingpong_sort)(SORT_TYPE src[], SORT_TYPE dst[], const int n, const int to_dst) {
+    if (n <= TYPED_MERGE_LEAF) {
+        SORT_FN(insertion_sort)(src, n);
+        if (to_dst) memcpy(dst, src, n * sizeof(SORT_TYPE));
+        return;
+    }
+
+    const int half = n / 2;
+    SORT_FN(pingpong_sort)(src, dst, half, !to_dst);
+    SORT_FN(pingpong_sort)(src + half, dst + half, n - half, !to_dst);
+
+    if (to_dst) {
+        SORT_FN(merge_halves)(src, half, src + half, n - half, dst);
+    } else {
+        SORT_FN(merge_halves)(dst, half, dst + half, n - half, src);
+    }
+}
+
+void SORT_CONCAT(SORT_FN(stable_sort), ws)(SORT_TYPE arr[], const int n, SortWorkspace* ws) {
+    if (n <= TYPED_MERGE_LEAF) {
+        SORT_FN(insertion_sort)(arr, n);
+        return;
+    }
+
+    SORT_TYPE* temp = workspace_reserve_bytes(ws, (size_t)n * sizeof(SORT_TYPE));
+    SORT_FN(pingpong_sort)(arr, temp, n, 0);
+}
+
+void SORT_FN(stable_sort)(SORT_TYPE arr[], const int n) {
+    SORT_CONCAT(SORT_FN(stable_sort), ws)(arr, n, thread_workspace());
+}
+
+// Tri par base LSD sur les octets de SORT_KEY, même schéma que lsd_radix_sort
+// de radix_sort.c: histogrammes en une lecture, passages triviaux sautés.
+void SORT_CONCAT(SORT_FN(radix_sort), ws)(SORT_TYPE arr[], const int n, SortWorkspace* ws) {
+    if (n <= TYPED_RADIX_CUTOFF) {
+        SORT_FN(insertion_sort)(arr, n);
+        return;
+    }
+
+    enum { passes = sizeof(SORT_KEY_TYPE) };
+    int counts[passes][256];
+    memset(counts, 0, sizeof(counts));
+
+    for (int i = 0; i < n; i++) {
+        const SORT_KEY_TYPE key = SORT_KEY(arr[i]);
+        for (int p = 0; p < passes; p++) {
+            counts[p][(key >> (8 * p)) & 0xFF]++;
+        }
+    }
+
+    SORT_TYPE* temp = workspace_reserve_bytes(ws, (size_t)n * sizeof(SORT_TYPE));
+    SORT_TYPE* src = arr;
+    SORT_TYPE* dst = temp;
+
+    for (int p = 0; p < passes; p++) {
+        const int shift = 8 * p;
+        int* count = counts[p];
+
+        if (count[(SORT_KEY(src[0]) >> shift) & 0xFF] == n) continue;
+
+        int offset = 0;
+        for (int b = 0; b < 256; b++) {
+            const int c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+
+        for (int i = 0; i < n; i++) {
+            dst[count[(SORT_KEY(src[i]) >> shift) & 0xFF]++] = src[i];
+        }
+
+        SORT_TYPE* swap_buffers = src;
+        src = dst;
+        dst = swap_buffers;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, (size_t)n * sizeof(SORT_TYPE));
+    }
+}
+
+void SORT_FN(radix_sort)(SORT_TYPE arr[], const int n) {
+    SORT_CONCAT(SORT_FN(radix_sort), ws)(arr, n, thread_workspace());
+}
+
+int SORT_FN(is_sorted)(const SORT_TYPE arr[], const int n) {
+    for (int i = 1; i < n; i++) {
+        if (SORT_LESS(arr[i], arr[i - 1])) return 0;
+    }
+    return 1;
+}
+
+#undef SORT_FN
+#undef SORT_CONCAT
+#undef SORT_CONCAT_
+#undef SORT_SUFFIX
+#undef SORT_TYPE
+#undef SORT_LESS
+#undef SORT_KEY_TYPE
+#undef SORT_KEY
@@ -2,7 +2,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
 #include "tri_composite.h"
+#include "benchmark.h"
+#include "perf_counters.h"
+#include "generator.h"
+
+// Compteurs d'opérations des noyaux instrumentés (un exemplaire par thread)
+_Thread_local unsigned long comparisons = 0;
+_Thread_local unsigned long swaps = 0;
 
 // Reinitialization des compteurs
 void reset_counters() {
@@ -10,6 +20,93 @@ void reset_counters() {
     swaps = 0;
 }
 
+// Lit les compteurs du thread courant
+void read_counters(SortStats* stats) {
+    stats->comparisons = comparisons;
+    stats->swaps = swaps;
+}
+
+// Ajoute des compteurs accumulés ailleurs (ex: par un autre thread) à ceux du thread courant
+void merge_counters(const SortStats* stats) {
+    comparisons += stats->comparisons;
+    swaps += stats->swaps;
+}
+
+// Trie arr et retourne les opérations de cet appel seulement.
+// Les compteurs du thread appelant sont préservés.
+void sort_with_stats(int arr[], const int n, void (*sort_function)(int[], int), SortStats* stats) {
+    SortStats saved;
+    read_counters(&saved);
+
+    reset_counters();
+    sort_function(arr, n);
+    read_counters(stats);
+
+    comparisons = saved.comparisons;
+    swaps = saved.swaps;
+}
+
+// Matrice (liste x algorithme) partagée entre les threads de compute_stats_matrix
+typedef struct {
+    int** inputs;
+    int num_inputs;
+    int size;
+    void (**sort_functions)(int[], int);
+    int num_algorithms;
+    SortStats* results;
+    atomic_int next;
+} StatsMatrix;
+
+static void* stats_matrix_worker(void* arg) {
+    StatsMatrix* matrix = arg;
+    const int total = matrix->num_inputs * matrix->num_algorithms;
+    int* work = malloc(matrix->size * sizeof(int));
+
+    // Chaque thread prend la prochaine cellule libre jusqu'à épuisement
+    for (int cell = atomic_fetch_add(&matrix->next, 1); cell < total;
+         cell = atomic_fetch_add(&matrix->next, 1)) {
+        const int input = cell / matrix->num_algorithms;
+        const int algorithm = cell % matrix->num_algorithms;
+
+        copy_array(matrix->inputs[input], work, matrix->size);
+        sort_with_stats(work, matrix->size, matrix->sort_functions[algorithm],
+                        &matrix->results[cell]);
+    }
+
+    free(work);
+    return NULL;
+}
+
+// Calcule les compteurs de chaque algorithme sur chaque liste, sur tous les cœurs.
+// results[i * num_algorithms + a] reçoit les opérations de l'algorithme a sur inputs[i].
+void compute_stats_matrix(int* inputs[], const int num_inputs, const int size,
+                          void (*sort_functions[])(int[], int), const int num_algorithms,
+                          SortStats results[]) {
+    StatsMatrix matrix = {inputs, num_inputs, size, sort_functions, num_algorithms, results, 0};
+
+    const int total = num_inputs * num_algorithms;
+    long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > total) num_threads = total;
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, stats_matrix_worker, &matrix) != 0) break;
+        started++;
+    }
+
+    // Si aucun thread n'a pu être créé, le thread courant fait tout le travail
+    if (started == 0) {
+        stats_matrix_worker(&matrix);
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+}
+
 // Affiche d'une liste
 void print_array(int arr[], int size) {
     for (int i = 0; i < size; i++) {
@@ -23,65 +120,158 @@ void copy_array(int src[], int dest[], int size) {
     memcpy(dest, src, size * sizeof(int));
 }
 
-// Créer différents types de liste (triée, inversée, presque triée, aléatoire)
+// Créer différents types de liste (triée, inversée, presque triée, aléatoire,
+// Zipf, ...: voir GenPattern dans common/generator.h). Un type inconnu donne
+// une liste aléatoire. Chaque appel reçoit sa propre graine, dérivée de
+// BENCH_SEED s'il est défini: les listes sont reproductibles d'une exécution à l'autre.
 int* create_array(int size, char* type) {
+    static uint64_t base_seed;
+    static uint64_t calls;
+    if (calls++ == 0) base_seed = generator_default_seed();
+
     int* arr = (int*)malloc(size * sizeof(int));
+    const int pattern = generator_pattern_from_name(type);
+    generate_pattern(arr, size, pattern >= 0 ? pattern : GEN_RANDOM, base_seed + calls);
+    return arr;
+}
 
-    if (strcmp(type, "sorted") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = i;
-        }
-    } else if (strcmp(type, "reverse") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = size - i - 1;
-        }
-    } else if (strcmp(type, "nearly_sorted") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = i;
-        }
+// Vérifie que la liste est triée par ordre croissant
+int is_sorted(int arr[], const int size) {
+    for (int i = 1; i < size; i++) {
+        if (arr[i - 1] > arr[i]) return 0;
+    }
+    return 1;
+}
 
-        // On permute 5% des éléments pour rendre la liste presque triée
-        int permutations = size * 0.05;
-        for (int i = 0; i < permutations; i++) {
-            int pos1 = rand() % size;
-            int pos2 = rand() % size;
-            int temp = arr[pos1];
-            arr[pos1] = arr[pos2];
-            arr[pos2] = temp;
+// Retourne le temps CPU (en secondes) pris par un algorithme de tri
+double time_sort(int array[], const int size, void (*sort_function)(int[], int)) {
+    clock_t start = clock();
+
+    sort_function(array, size);
+
+    clock_t end = clock();
+
+    return ((double) (end - start)) / CLOCKS_PER_SEC;
+}
+
+// Retourne le temps réel écoulé (en secondes), seul pertinent pour les tris parallèles
+double wall_time_sort(int array[], const int size, void (*sort_function)(int[], int)) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    sort_function(array, size);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// Un essai de measure_time: on recopie l'entrée d'origine puis on trie
+typedef struct {
+    int* array;
+    int* input;
+    int size;
+    void (*sort_function)(int[], int);
+} SortTrial;
+
+static void restore_trial_input(void* arg) {
+    const SortTrial* trial = arg;
+    copy_array(trial->input, trial->array, trial->size);
+}
+
+static void run_trial_sort(void* arg) {
+    const SortTrial* trial = arg;
+    trial->sort_function(trial->array, trial->size);
+}
+
+// Compteurs matériels (BENCH_PERF=1), ouverts au premier appel de measure_time
+static PerfCounters perf_counters;
+static int perf_state = 0; // 0: pas encore essayé, 1: actifs, -1: inactifs
+
+static int perf_ready(void) {
+    if (perf_state == 0) {
+        perf_state = -1;
+        if (perf_enabled_from_env()) {
+            if (perf_counters_open(&perf_counters) > 0) {
+                perf_state = 1;
+            } else {
+                fprintf(stderr, "Compteurs matériels indisponibles "
+                        "(voir /proc/sys/kernel/perf_event_paranoid), BENCH_PERF ignoré\n");
+            }
         }
-    } else {
-        for (int i = 0; i < size; i++) {
-            arr[i] = i;
+    }
+    return perf_state == 1;
+}
+
+// Un tri de plus, sous compteurs matériels; affiche les événements par élément
+static void print_perf_counters(const SortTrial* trial) {
+    PerfSample sample;
+    restore_trial_input((void*)trial);
+    perf_counters_start(&perf_counters);
+    trial->sort_function(trial->array, trial->size);
+    perf_counters_stop(&perf_counters, &sample);
+
+    printf("    par élément:");
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (sample.valid[e]) {
+            printf(" %s %.2f", perf_event_name(e), sample.values[e] / trial->size);
+        } else {
+            printf(" %s n/a", perf_event_name(e));
         }
-        shuffle_array(arr, size);
     }
-    return arr;
+    if (sample.valid[PERF_CYCLES] && sample.valid[PERF_INSTRUCTIONS] && sample.values[PERF_CYCLES] > 0) {
+        printf(", IPC %.2f", sample.values[PERF_INSTRUCTIONS] / sample.values[PERF_CYCLES]);
+    }
+    printf("\n");
 }
 
-// Mesure le temps d'exécution pour un algorithme de tri
-void measure_time(int array[], int size,
-                 void (*sort_function)(int[], int), char* sort_name) {
-    reset_counters();
+// Mesure le temps d'exécution pour un algorithme de tri: médiane du temps
+// réel sur plusieurs essais après chauffe (voir common/benchmark.h), et
+// compteurs d'opérations du premier tri. uncounted_function, la copie du
+// même tri compilée sans compteurs (-DSORT_UNCOUNTED), est mesurée sur la
+// même entrée pour donner le coût de l'instrumentation (NULL: pas de
+// comparaison). Avec BENCH_PERF=1, on ajoute les compteurs matériels par
+// élément. array est trié au retour.
+void measure_time(int array[], int size, void (*sort_function)(int[], int),
+                  void (*uncounted_function)(int[], int), char* sort_name) {
+    int* input = malloc(size * sizeof(int));
+    copy_array(array, input, size);
 
-    clock_t start = clock();
+    SortStats stats;
+    sort_with_stats(array, size, sort_function, &stats);
 
-    sort_function(array, size);
+    BenchConfig config;
+    bench_config_from_env(&config);
+    BenchResult result;
+    SortTrial trial = {array, input, size, sort_function};
+    bench_measure(&config, restore_trial_input, run_trial_sort, &trial, &result);
 
-    clock_t end = clock();
+    printf("- %s: %.6f secondes (médiane de %d, p95 %.6f), %lu comparaisons, %lu permutations\n",
+           sort_name, result.wall.median, result.trials, result.wall.p95,
+           stats.comparisons, stats.swaps);
 
-    double cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+    if (perf_ready()) {
+        print_perf_counters(&trial);
+    }
 
+    if (uncounted_function != NULL) {
+        BenchResult uncounted;
+        SortTrial uncounted_trial = {array, input, size, uncounted_function};
+        bench_measure(&config, restore_trial_input, run_trial_sort, &uncounted_trial, &uncounted);
+        printf("    sans compteurs: %.6f secondes (instrumentation: %.2fx)\n", uncounted.wall.median,
+               uncounted.wall.median > 0 ? result.wall.median / uncounted.wall.median : 0.0);
+    }
 
-    printf("- %s: %.6f secondes, %lu comparaisons, %lu permutations\n",
-           sort_name, cpu_time_used, comparisons, swaps);
+    free(input);
 }
 
-// Fonction pour mélanger une liste de taille n
+// Fonction pour mélanger une liste de taille n (uniforme, sans le biais de rand() % k)
 void shuffle_array(int arr[], int n) {
-    for (int i = n - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = arr[i];
-        arr[i] = arr[j];
-        arr[j] = temp;
+    static _Thread_local Rng rng;
+    static _Thread_local int seeded;
+    if (!seeded) {
+        rng_seed(&rng, generator_default_seed());
+        seeded = 1;
     }
-}
\ No newline at end of file
+    rng_shuffle(&rng, arr, n);
+}
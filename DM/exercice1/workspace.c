@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "tri_composite.h"
+
+// Capacité minimale d'un espace de travail, en octets (évite une suite de petites croissances)
+#define WORKSPACE_MIN_CAPACITY 4096
+
+void workspace_init(SortWorkspace* ws) {
+    ws->data = NULL;
+    ws->capacity = 0;
+    ws->allocations = 0;
+}
+
+// Retourne un tampon d'au moins `bytes` octets. Le tampon grandit par
+// doublement et n'est jamais réduit: après le plus grand tri, plus aucune
+// allocation. Son contenu n'est pas conservé d'un appel à l'autre.
+void* workspace_reserve_bytes(SortWorkspace* ws, const size_t bytes) {
+    if (bytes <= ws->capacity) return ws->data;
+
+    size_t capacity = ws->capacity > 0 ? 2 * ws->capacity : WORKSPACE_MIN_CAPACITY;
+    if (capacity < bytes) capacity = bytes;
+
+    // Pas de realloc: l'ancien contenu n'a pas besoin d'être recopié
+    void* data = malloc(capacity);
+    if (data == NULL) return NULL;
+
+    free(ws->data);
+    ws->data = data;
+    ws->capacity = capacity;
+    ws->allocations++;
+    return data;
+}
+
+// Tampon d'au moins n entiers
+int* workspace_reserve(SortWorkspace* ws, const int n) {
+    return workspace_reserve_bytes(ws, (size_t)n * sizeof(int));
+}
+
+void workspace_release(SortWorkspace* ws) {
+    free(ws->data);
+    workspace_init(ws);
+}
+
+// Espace de travail propre à chaque thread, libéré quand le thread se termine
+static pthread_key_t workspace_key;
+static pthread_once_t workspace_key_once = PTHREAD_ONCE_INIT;
+
+static void destroy_thread_workspace(void* arg) {
+    workspace_release(arg);
+    free(arg);
+}
+
+static void create_workspace_key(void) {
+    pthread_key_create(&workspace_key, destroy_thread_workspace);
+}
+
+// Espace de travail des versions sans paramètre `ws` (merge_sort_recursive, ...)
+SortWorkspace* thread_workspace(void) {
+    pthread_once(&workspace_key_once, create_workspace_key);
+
+    SortWorkspace* ws = pthread_getspecific(workspace_key);
+    if (ws == NULL) {
+        ws = malloc(sizeof(SortWorkspace));
+        workspace_init(ws);
+        pthread_setspecific(workspace_key, ws);
+    }
+    return ws;
+}
@@ -1,13 +1,227 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <stdbool.h>
-#include <time.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
 #include <math.h>
+#include <immintrin.h>
 #include "deux_elements.h"
+#include "gap_index.h"
+#include "typed_sort.h"
+#include "benchmark.h"
+#include "generator.h"
+
+// Un essai chronométré d'une des deux approches
+typedef struct {
+    Pair (*approach)(int[], int);
+    int* S;
+    int n;
+    Pair result;
+} PairTrial;
+
+static void run_pair_trial(void* arg) {
+    PairTrial* trial = arg;
+    trial->result = trial->approach(trial->S, trial->n);
+}
+
+// Tailles par défaut du passage à l'échelle (sans l'approche naïve)
+static const int default_large_sizes[] = {1000000, 10000000};
+
+// Ensemble dynamique: tailles, remplacements mesurés avec l'index, dont les
+// premiers sont aussi recalculés par optimized_approach, et taille des lots
+static const int dynamic_sizes[] = {100000, 1000000};
+#define DYNAMIC_UPDATES 1000000
+#define DYNAMIC_RECOMPUTED 200
+#define DYNAMIC_BATCH 1000
+
+static void print_timing(const BenchResult* result) {
+    printf("   Temps d'exécution: %.9f secondes (médiane de %d, p95 %.9f, IC 95 %% [%.9f, %.9f])\n",
+           result->wall.median, result->trials, result->wall.p95,
+           result->wall.ci_low, result->wall.ci_high);
+}
+
+static int same_pair(const Pair a, const Pair b) {
+    return a.x == b.x && a.y == b.y && a.diff == b.diff;
+}
+
+// Seaux contre tri sur une grande liste; les deux doivent donner la même paire
+static void bench_large_input(const BenchConfig* config, BenchReport* report, int S[], const int n,
+                              const char* pattern) {
+    PairTrial sorting = {sorting_approach, S, n, {0, 0, -1}};
+    BenchResult bench_sorting = {"exercice2", "sorting_approach", pattern, n, 0,
+                                 {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+    bench_measure(config, NULL, run_pair_trial, &sorting, &bench_sorting);
+    bench_report_add(report, &bench_sorting);
+
+    PairTrial opt = {optimized_approach, S, n, {0, 0, -1}};
+    BenchResult bench_opt = {"exercice2", "optimized_approach", pattern, n, 0,
+                             {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+    bench_measure(config, NULL, run_pair_trial, &opt, &bench_opt);
+    bench_report_add(report, &bench_opt);
+
+    if (!same_pair(sorting.result, opt.result)) {
+        fprintf(stderr, "Erreur: seaux (%d, %d) et tri (%d, %d) ne donnent pas la même paire (%s)\n",
+                opt.result.x, opt.result.y, sorting.result.x, sorting.result.y, pattern);
+        exit(1);
+    }
+
+    printf("Paire la plus proche: (%d, %d), |x-y| = %.0f\n", opt.result.x, opt.result.y, opt.result.diff);
+    printf("\nPar tri (O(n log n)):\n");
+    print_timing(&bench_sorting);
+    printf("\nPar seaux (O(n)):\n");
+    print_timing(&bench_opt);
+    printf("   Accélération: %.2fx, %.1f M éléments/s\n", bench_sorting.wall.median / bench_opt.wall.median,
+           n / bench_opt.wall.median / 1e6);
+}
+
+// Grandes listes: valeurs distinctes dans toute la plage des int, pour que
+// les écarts dépassent la précision d'un int, puis valeurs groupées entre
+// les deux extrêmes (presque tout dans un seul tiroir)
+static void bench_large(const BenchConfig* config, BenchReport* report, const int sizes[], const int num_sizes) {
+    for (int t = 0; t < num_sizes; t++) {
+        const int n = sizes[t];
+        printf("\n=== Passage à l'échelle avec n = %d ===\n", n);
+        int* S = generate_random_array(n, INT_MIN, INT_MAX);
+        bench_large_input(config, report, S, n, "random");
+        free(S);
+
+        printf("\n=== Passage à l'échelle avec n = %d, valeurs groupées ===\n", n);
+        S = generate_clustered_array(n);
+        bench_large_input(config, report, S, n, "clustered");
+        free(S);
+    }
+}
+
+// Ensemble qui change: chaque remplacement retire une valeur au hasard et en
+// ajoute une nouvelle, puis demande la paire la plus proche. L'index la
+// maintient en O(log n) par mise à jour; sinon, optimized_approach recalcule
+// tout (O(n)). Les deux sont comparés à chaque étape des premiers
+// remplacements.
+static void bench_dynamic(const int sizes[], const int num_sizes) {
+    for (int t = 0; t < num_sizes; t++) {
+        const int n = sizes[t];
+        printf("\n=== Ensemble dynamique avec n = %d ===\n", n);
+
+        int* S = generate_random_array(n, INT_MIN, INT_MAX);
+        Rng rng;
+        rng_seed(&rng, generator_default_seed() + n);
+
+        GapIndex index;
+        gap_index_init(&index);
+        double start = bench_wall_time();
+        gap_index_insert_batch(&index, S, n);
+        const double build = bench_wall_time() - start;
+
+        // Remplacements vérifiés: index contre recalcul complet
+        double indexed = 0;
+        double recomputed = 0;
+        for (int u = 0; u < DYNAMIC_RECOMPUTED; u++) {
+            const int i = rng_bounded(&rng, n);
+            const int value = (int)(uint32_t)rng_next(&rng);
+
+            start = bench_wall_time();
+            gap_index_delete(&index, S[i]);
+            gap_index_insert(&index, value);
+            const Pair dynamic = gap_index_min_pair(&index);
+            indexed += bench_wall_time() - start;
+
+            S[i] = value;
+            start = bench_wall_time();
+            const Pair full = optimized_approach(S, n);
+            recomputed += bench_wall_time() - start;
+
+            if (!same_pair(dynamic, full)) {
+                fprintf(stderr, "Erreur: l'index donne (%d, %d), optimized_approach (%d, %d)\n",
+                        dynamic.x, dynamic.y, full.x, full.y);
+                exit(1);
+            }
+        }
+
+        // Index seul, remplacements un par un
+        start = bench_wall_time();
+        double checksum = 0;
+        for (int u = 0; u < DYNAMIC_UPDATES; u++) {
+            const int i = rng_bounded(&rng, n);
+            const int value = (int)(uint32_t)rng_next(&rng);
+            gap_index_delete(&index, S[i]);
+            gap_index_insert(&index, value);
+            S[i] = value;
+            checksum += gap_index_min_pair(&index).diff;
+        }
+        const double single = (bench_wall_time() - start) / DYNAMIC_UPDATES;
+
+        // Index seul, remplacements par lots de DYNAMIC_BATCH (une requête par lot)
+        int* removed = malloc(DYNAMIC_BATCH * sizeof(int));
+        int* added = malloc(DYNAMIC_BATCH * sizeof(int));
+        start = bench_wall_time();
+        for (int u = 0; u < DYNAMIC_UPDATES; u += DYNAMIC_BATCH) {
+            // Positions distinctes dans un lot: chaque valeur retirée est bien dans l'index
+            const int first = rng_bounded(&rng, n);
+            for (int b = 0; b < DYNAMIC_BATCH; b++) {
+                const int i = (first + b) % n;
+                removed[b] = S[i];
+                added[b] = (int)(uint32_t)rng_next(&rng);
+                S[i] = added[b];
+            }
+            gap_index_delete_batch(&index, removed, DYNAMIC_BATCH);
+            gap_index_insert_batch(&index, added, DYNAMIC_BATCH);
+            checksum += gap_index_min_pair(&index).diff;
+        }
+        const double batched = (bench_wall_time() - start) / DYNAMIC_UPDATES;
+        free(removed);
+        free(added);
+
+        if (!same_pair(gap_index_min_pair(&index), optimized_approach(S, n)) || index.size != n) {
+            fprintf(stderr, "Erreur: l'index diffère de optimized_approach après les lots\n");
+            exit(1);
+        }
 
-int main() {
-    // Initialisation du générateur de nombres aléatoires
-    srand(time(NULL));
+        const double per_recompute = recomputed / DYNAMIC_RECOMPUTED;
+        printf("Construction de l'index (lot trié): %.6f s\n", build);
+        printf("Recalcul par optimized_approach:    %12.3f µs par remplacement (%d remplacements)\n",
+               per_recompute * 1e6, DYNAMIC_RECOMPUTED);
+        printf("Index (vérifié à chaque étape):     %12.3f µs par remplacement\n",
+               indexed / DYNAMIC_RECOMPUTED * 1e6);
+        printf("Index, un par un:                   %12.3f µs par remplacement (%d remplacements), %.0fx\n",
+               single * 1e6, DYNAMIC_UPDATES, per_recompute / single);
+        printf("Index, lots de %d:                %12.3f µs par remplacement, %.0fx\n",
+               DYNAMIC_BATCH, batched * 1e6, per_recompute / batched);
+        printf("   (somme de contrôle des écarts: %.0f)\n", checksum);
+
+        gap_index_free(&index);
+        free(S);
+    }
+}
+
+// Usage: ./deux_elements [n ...]
+// Sans argument: questions (a) et (b) jusqu'à 10⁵, passage à l'échelle
+// à 10⁶ et 10⁷, puis ensemble dynamique (index contre recalcul). Avec des
+// tailles (jusqu'à 10⁹, environ 12 octets par élément): passage à
+// l'échelle seul.
+int main(int argc, char* argv[]) {
+    // Mesures avec chauffe et essais répétés (réglages: voir common/benchmark.h)
+    BenchConfig config;
+    bench_config_from_env(&config);
+    if (config.cpu >= 0 && bench_pin_cpu(config.cpu) != 0) {
+        fprintf(stderr, "Impossible d'épingler le thread sur le cœur %d\n", config.cpu);
+    }
+    BenchReport report;
+    bench_report_open(&report);
+
+    if (argc > 1) {
+        int sizes[argc - 1];
+        for (int i = 1; i < argc; i++) {
+            const long n = atol(argv[i]);
+            if (n < 2 || n > INT_MAX) {
+                fprintf(stderr, "Taille invalide: %s\n", argv[i]);
+                return 1;
+            }
+            sizes[i - 1] = n;
+        }
+        bench_large(&config, &report, sizes, argc - 1);
+        bench_report_close(&report);
+        return 0;
+    }
 
     // Tests avec différentes tailles d'ensemble
     const int test_sizes[] = {10, 100, 1000, 10000, 100000};
@@ -28,20 +242,24 @@ int main() {
         printf("Seuil = %f\n", threshold);
 
         // (a) Approche naïve
-        const clock_t start_naive = clock();
-        const Pair result_naive = naive_approach(S, n);
-        const clock_t end_naive = clock();
-        const double time_naive = (double)(end_naive - start_naive) / CLOCKS_PER_SEC;
+        PairTrial naive = {naive_approach, S, n, {0, 0, -1}};
+        BenchResult bench_naive = {"exercice2", "naive_approach", "random", n, 0,
+                                   {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+        bench_measure(&config, NULL, run_pair_trial, &naive, &bench_naive);
+        bench_report_add(&report, &bench_naive);
+        const Pair result_naive = naive.result;
 
         // (b) Approche optimisée
-        const clock_t start_opt = clock();
-        const Pair result_opt = optimized_approach(S, n);
-        const clock_t end_opt = clock();
-        const double time_opt = (double)(end_opt - start_opt) / CLOCKS_PER_SEC;
+        PairTrial opt = {optimized_approach, S, n, {0, 0, -1}};
+        BenchResult bench_opt = {"exercice2", "optimized_approach", "random", n, 0,
+                                 {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+        bench_measure(&config, NULL, run_pair_trial, &opt, &bench_opt);
+        bench_report_add(&report, &bench_opt);
+        const Pair result_opt = opt.result;
 
         // Afficher les résultats
         printf("\n(a) Approche naïve (O(n²)):\n");
-        printf("   Temps d'exécution: %.6f secondes\n", time_naive);
+        print_timing(&bench_naive);
         if (result_naive.x != result_naive.y) {
             printf("   Paire trouvée: (%d, %d) avec |x-y| = %.2f <= %.2f\n",
                    result_naive.x, result_naive.y, fabs(result_naive.diff), threshold);
@@ -50,45 +268,74 @@ int main() {
         }
 
         printf("\n(b) Approche optimisée (O(n)):\n");
-        printf("   Temps d'exécution: %.6f secondes\n", time_opt);
+        print_timing(&bench_opt);
         if (result_opt.x != result_opt.y) {
             printf("   Paire trouvée: (%d, %d) avec |x-y| = %.2f <= %.2f\n",
                    result_opt.x, result_opt.y, fabs(result_opt.diff), threshold);
         } else {
             printf("   Aucune paire trouvée\n");
         }
+        if (!same_pair(result_opt, sorting_approach(S, n))) {
+            fprintf(stderr, "Erreur: optimized_approach diffère de sorting_approach\n");
+            exit(1);
+        }
+        free(S);
+
+        // Valeurs groupées: un tiroir presque plein, même paire attendue
+        S = generate_clustered_array(n);
+        if (!same_pair(optimized_approach(S, n), sorting_approach(S, n))) {
+            fprintf(stderr, "Erreur: optimized_approach diffère de sorting_approach (valeurs groupées)\n");
+            exit(1);
+        }
         free(S);
     }
 
+    bench_large(&config, &report, default_large_sizes,
+                sizeof(default_large_sizes) / sizeof(default_large_sizes[0]));
+    bench_dynamic(dynamic_sizes, sizeof(dynamic_sizes) / sizeof(dynamic_sizes[0]));
+
+    bench_report_close(&report);
     return 0;
 }
 
 /**
  * Génère un tableau d'entiers aléatoires distincts
+ *
+ * Les valeurs sont les images de 0..n-1 par une permutation pseudo-aléatoire
+ * de la plage (common/generator.h): O(n) même quand n approche la taille de
+ * la plage, sans table de la taille de la plage ni tirages répétés.
+ * Graine: BENCH_SEED s'il est défini.
  */
 int* generate_random_array(const int n, const int min_val, const int max_val) {
+    static uint64_t calls;
+    static uint64_t base_seed;
+    if (calls++ == 0) base_seed = generator_default_seed();
+
     int* arr = malloc(n * sizeof(int));
 
     // Nous voulons des entiers distincts, donc on s'assure que la plage est assez grande
-    if (max_val - min_val + 1 < n) {
+    if (generate_distinct(arr, n, min_val, max_val, base_seed + calls) != 0) {
         printf("Erreur: Plage trop petite pour générer %d entiers distincts\n", n);
         exit(1);
     }
 
-    // Utiliser un tableau pour suivre les nombres déjà utilisés
-    bool* used = calloc(max_val - min_val + 1, sizeof(bool));
-
-    for (int i = 0; i < n; i++) {
-        int num;
-        do {
-            num = min_val + rand() % (max_val - min_val + 1);
-        } while (used[num - min_val]);
-
-        arr[i] = num;
-        used[num - min_val] = true;
-    }
+    return arr;
+}
 
-    free(used);
+/**
+ * Génère un tableau de valeurs groupées: INT_MIN, INT_MAX et n - 2 valeurs
+ * distinctes dans une fenêtre d'environ 2^32 / n (au moins n valeurs) à
+ * partir de 0. Le seuil vaut à peu près la largeur de la fenêtre: presque
+ * tous les éléments tombent dans un ou deux tiroirs de optimized_approach.
+ */
+int* generate_clustered_array(const int n) {
+    const long window = (long)UINT32_MAX / n;
+    const long width = window > n ? window : n;
+    int* arr = generate_random_array(n, 0, width - 1);
+
+    // Ordre aléatoire: les extrêmes remplacent deux valeurs quelconques
+    arr[0] = INT_MIN;
+    arr[n / 2] = INT_MAX;
     return arr;
 }
 
@@ -104,36 +351,89 @@ void print_array(int arr[], const int n) {
 }
 
 /**
- * Trouve la valeur minimale dans un tableau
+ * Minimum et maximum en une passe, scalaire
  */
-int find_min(const int arr[], const int n) {
-    int min_val = arr[0];
+static void min_max_scalar(const int arr[], const int n, int* min_val, int* max_val) {
+    int lo = arr[0];
+    int hi = arr[0];
     for (int i = 1; i < n; i++) {
-        if (arr[i] < min_val) {
-            min_val = arr[i];
-        }
+        if (arr[i] < lo) lo = arr[i];
+        if (arr[i] > hi) hi = arr[i];
     }
-    return min_val;
+    *min_val = lo;
+    *max_val = hi;
 }
 
 /**
- * Trouve la valeur maximale dans un tableau
+ * Minimum et maximum en une passe, 32 entiers par itération (AVX2): quatre
+ * paires d'accumulateurs indépendants, sans branchement
  */
-int find_max(const int arr[], const int n) {
-    int max_val = arr[0];
-    for (int i = 1; i < n; i++) {
-        if (arr[i] > max_val) {
-            max_val = arr[i];
+__attribute__((target("avx2")))
+static void min_max_avx2(const int arr[], const int n, int* min_val, int* max_val) {
+    __m256i lo[4], hi[4];
+    for (int a = 0; a < 4; a++) {
+        lo[a] = _mm256_set1_epi32(arr[0]);
+        hi[a] = lo[a];
+    }
+
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        for (int a = 0; a < 4; a++) {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i + 8 * a));
+            lo[a] = _mm256_min_epi32(lo[a], v);
+            hi[a] = _mm256_max_epi32(hi[a], v);
         }
     }
-    return max_val;
+
+    const __m256i lo_all = _mm256_min_epi32(_mm256_min_epi32(lo[0], lo[1]), _mm256_min_epi32(lo[2], lo[3]));
+    const __m256i hi_all = _mm256_max_epi32(_mm256_max_epi32(hi[0], hi[1]), _mm256_max_epi32(hi[2], hi[3]));
+    int lanes_lo[8], lanes_hi[8];
+    _mm256_storeu_si256((__m256i*)lanes_lo, lo_all);
+    _mm256_storeu_si256((__m256i*)lanes_hi, hi_all);
+
+    int result_lo = lanes_lo[0];
+    int result_hi = lanes_hi[0];
+    for (int l = 1; l < 8; l++) {
+        if (lanes_lo[l] < result_lo) result_lo = lanes_lo[l];
+        if (lanes_hi[l] > result_hi) result_hi = lanes_hi[l];
+    }
+    for (; i < n; i++) {
+        if (arr[i] < result_lo) result_lo = arr[i];
+        if (arr[i] > result_hi) result_hi = arr[i];
+    }
+    *min_val = result_lo;
+    *max_val = result_hi;
+}
+
+/**
+ * Trouve le minimum et le maximum d'un tableau en une seule lecture
+ * (AVX2 si le processeur le permet)
+ */
+void find_min_max(const int arr[], const int n, int* min_val, int* max_val) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        min_max_avx2(arr, n, min_val, max_val);
+    } else {
+        min_max_scalar(arr, n, min_val, max_val);
+    }
+}
+
+/**
+ * Trouve la valeur minimale dans un tableau
+ */
+int find_min(const int arr[], const int n) {
+    int min_val, max_val;
+    find_min_max(arr, n, &min_val, &max_val);
+    return min_val;
 }
 
 /**
- * Fonction de comparaison pour qsort
+ * Trouve la valeur maximale dans un tableau
  */
-int compare_ints(const void* a, const void* b) {
-    return *(int*)a - *(int*)b;
+int find_max(const int arr[], const int n) {
+    int min_val, max_val;
+    find_min_max(arr, n, &min_val, &max_val);
+    return max_val;
 }
 
 /**
@@ -163,17 +463,54 @@ Pair naive_approach(int S[], const int n) {
     return result;
 }
 
+// Groupes de tiroirs de l'approche (b): au plus OPT_MAX_GROUPS flux
+// d'écriture lors de la répartition, au moins 2^OPT_MIN_GROUP_SHIFT tiroirs
+// par groupe
+#define OPT_MAX_GROUPS 1024
+#define OPT_MIN_GROUP_SHIFT 12
+
+// Tiroir de l'approche (b): seuls le minimum, le maximum et le nombre
+// d'éléments sont conservés
+typedef struct {
+    int min;
+    int max;
+    unsigned count;
+    // Tiroirs d'au moins trois éléments: fin de leurs éléments dans le tampon
+    unsigned end;
+} Bucket;
+
+// Tiroir courant d'un élément: croissant avec x (même arrondi pour tous), ce
+// qui suffit pour que les tiroirs soient dans l'ordre des valeurs
+static inline int bucket_of(const int x, const int min_val, const double scale) {
+    return (int)(((double)x - min_val) * scale);
+}
+
 /**
  * (b) Approche optimisée en O(n)
  * Utilise le principe des tiroirs (pigeonhole principle)
+ *
+ * n tiroirs de largeur seuil = (max - min) / (n - 1): x va dans le tiroir
+ * (x - min) / seuil. Deux éléments consécutifs dans l'ordre trié sont soit
+ * dans le même tiroir, soit le maximum d'un tiroir et le minimum du tiroir
+ * non vide suivant; ces derniers se lisent directement dans les tiroirs.
+ * Un tiroir à deux éléments donne sa paire (min, max); seuls les éléments des
+ * tiroirs plus peuplés (un quart en moyenne sur des valeurs uniformes, une
+ * poignée par tiroir) sont triés, tiroir par tiroir, par radix_sort_int32:
+ * linéaire même si presque toutes les valeurs tombent dans un seul tiroir
+ * (valeurs groupées entre deux extrêmes), et insertion sur les petits tiroirs.
+ *
+ * Pour ne pas payer un défaut de cache par élément, les éléments sont d'abord
+ * répartis (en une lecture et une écriture séquentielles) entre au plus
+ * OPT_MAX_GROUPS groupes de tiroirs consécutifs; chaque groupe est ensuite
+ * traité avec une table de tiroirs qui tient en cache.
  */
 Pair optimized_approach(int S[], const int n) {
     Pair result = {0, 0, -1}; // Initialisation avec une différence négative (non valide)
 
     // Trouver min et max
-    const int min_val = find_min(S, n);
-    const int max_val = find_max(S, n);
-    const double range = max_val - min_val;
+    int min_val, max_val;
+    find_min_max(S, n, &min_val, &max_val);
+    const double range = (double)max_val - min_val;
     const double threshold = range / (n - 1);
 
     // Si tous les éléments sont identiques
@@ -184,16 +521,140 @@ Pair optimized_approach(int S[], const int n) {
         return result;
     }
 
-    // Création d'une copie triée du tableau
-    int* sorted_S = malloc(n * sizeof(int));
+    const double scale = (n - 1) / range;
+    int shift = OPT_MIN_GROUP_SHIFT;
+    while (((n - 1) >> shift) >= OPT_MAX_GROUPS) shift++;
+    const int num_groups = ((n - 1) >> shift) + 1;
+
+    // Répartition stable par groupe (comptage, sommes préfixes, écriture)
+    long* offsets = calloc(num_groups + 1, sizeof(long));
+    for (int i = 0; i < n; i++) {
+        offsets[(bucket_of(S[i], min_val, scale) >> shift) + 1]++;
+    }
+    long largest_group = 0;
+    for (int g = 0; g < num_groups; g++) {
+        if (offsets[g + 1] > largest_group) largest_group = offsets[g + 1];
+        offsets[g + 1] += offsets[g];
+    }
+
+    int* grouped = malloc(n * sizeof(int));
+    long* fill = malloc(num_groups * sizeof(long));
+    memcpy(fill, offsets, num_groups * sizeof(long));
     for (int i = 0; i < n; i++) {
-        sorted_S[i] = S[i];
+        grouped[fill[bucket_of(S[i], min_val, scale) >> shift]++] = S[i];
     }
-    qsort(sorted_S, n, sizeof(int), compare_ints);
+    free(fill);
+
+    Bucket* buckets = malloc(((size_t)1 << shift) * sizeof(Bucket));
+    int* crowded = malloc((largest_group + 1) * sizeof(int));
+    uint64_t best = PAIR_NONE;
+    int previous_max = 0;
+    int has_previous = 0;
+
+    for (int g = 0; g < num_groups; g++) {
+        const int first_bucket = g << shift;
+        const int group_buckets = n - first_bucket < (1 << shift) ? n - first_bucket : 1 << shift;
+        const int* values = grouped + offsets[g];
+        const long count = offsets[g + 1] - offsets[g];
+        if (count == 0) continue;
+
+        for (int bucket = 0; bucket < group_buckets; bucket++) {
+            buckets[bucket] = (Bucket){INT_MAX, INT_MIN, 0, 0};
+        }
+        // Sans branchement: le nombre d'éléments par tiroir est imprévisible
+        for (long i = 0; i < count; i++) {
+            const int x = values[i];
+            Bucket* b = &buckets[bucket_of(x, min_val, scale) - first_bucket];
+            b->min = x < b->min ? x : b->min;
+            b->max = x > b->max ? x : b->max;
+            b->count++;
+        }
+
+        // Éléments des tiroirs d'au moins trois éléments, rangés tiroir par
+        // tiroir dans le tampon puis triés (quelques éléments par tiroir).
+        // Les autres tiroirs écrivent dans la case 0, jamais lue: pas de
+        // branchement par élément.
+        unsigned num_crowded = 1;
+        for (int bucket = 0; bucket < group_buckets; bucket++) {
+            Bucket* b = &buckets[bucket];
+            b->end = b->count >= 3 ? num_crowded : 0;
+            num_crowded += b->count >= 3 ? b->count : 0;
+        }
+        if (num_crowded > 1) {
+            for (long i = 0; i < count; i++) {
+                Bucket* b = &buckets[bucket_of(values[i], min_val, scale) - first_bucket];
+                crowded[b->end] = values[i];
+                b->end += b->count >= 3;
+            }
+        }
+
+        for (int bucket = 0; bucket < group_buckets; bucket++) {
+            const Bucket* b = &buckets[bucket];
+            const int filled = b->count != 0;
+
+            // Maximum du tiroir non vide précédent et minimum de celui-ci
+            best = min_key(best, filled && has_previous ? PAIR_KEY(previous_max, b->min) : PAIR_NONE);
+            best = min_key(best, b->count == 2 ? PAIR_KEY(b->min, b->max) : PAIR_NONE);
+            if (b->count >= 3) {
+                int* sorted = crowded + b->end - b->count;
+                radix_sort_int32(sorted, b->count);
+                for (unsigned k = 1; k < b->count; k++) {
+                    best = min_key(best, PAIR_KEY(sorted[k - 1], sorted[k]));
+                }
+            }
+
+            previous_max = filled ? b->max : previous_max;
+            has_previous |= filled;
+        }
+    }
+
+    if (best != PAIR_NONE) {
+        const int x = (int)((uint32_t)best ^ 0x80000000u);
+        const double diff = (double)(best >> 32);
+        if (diff <= threshold) {
+            result.x = x;
+            result.y = (int)(x + (int64_t)(best >> 32));
+            result.diff = diff;
+        }
+    }
+
+    free(crowded);
+    free(buckets);
+    free(grouped);
+    free(offsets);
+
+    return result;
+}
+
+/**
+ * Référence de (b) en O(n log n): tri puis parcours des éléments consécutifs
+ */
+Pair sorting_approach(int S[], const int n) {
+    Pair result = {0, 0, -1}; // Initialisation avec une différence négative (non valide)
+
+    // Trouver min et max
+    int min_val, max_val;
+    find_min_max(S, n, &min_val, &max_val);
+    const double range = (double)max_val - min_val;
+    const double threshold = range / (n - 1);
+
+    // Si tous les éléments sont identiques
+    if (range == 0) {
+        result.x = min_val;
+        result.y = min_val;
+        result.diff = 0;
+        return result;
+    }
+
+    // Création d'une copie triée du tableau
+    int* sorted_S = malloc(n * sizeof(int));
+    memcpy(sorted_S, S, n * sizeof(int));
+    // Tri spécialisé pour les entiers (comparaison inlinée, pas de rappel comme qsort)
+    sort_int32(sorted_S, n);
 
     // Recherche de deux éléments consécutifs avec une différence suffisamment petite
     for (int i = 0; i < n - 1; i++) {
-        const double diff = sorted_S[i+1] - sorted_S[i];
+        const double diff = (double)sorted_S[i+1] - sorted_S[i];
         if (diff <= threshold && (result.diff < 0 || diff < result.diff)) {
             result.x = sorted_S[i];
             result.y = sorted_S[i+1];
@@ -205,4 +666,4 @@ Pair optimized_approach(int S[], const int n) {
     free(sorted_S);
 
     return result;
-}
\ No newline at end of file
+}
@@ -1,6 +1,8 @@
 #ifndef DEUX_ELEMENTS_H
 #define DEUX_ELEMENTS_H
 
+#include <stdint.h>
+
 // Structure pour représenter une paire d'éléments
 typedef struct {
     int x;
@@ -8,11 +10,23 @@ typedef struct {
     double diff;
 } Pair;
 
+// Paire candidate (x, y), x <= y, codée (écart << 32) | (x - INT_MIN): la
+// plus petite clé est la paire de plus petit écart puis de plus petit x,
+// c'est-à-dire la première trouvée par le parcours de sorting_approach
+#define PAIR_KEY(x, y) (((uint64_t)((int64_t)(y) - (x)) << 32) | ((uint32_t)(x) ^ 0x80000000u))
+#define PAIR_NONE UINT64_MAX
+
+static inline uint64_t min_key(const uint64_t a, const uint64_t b) {
+    return a < b ? a : b;
+}
+
 // Prototypes des fonctions
 int* generate_random_array(const int n, const int min_val, const int max_val);
+int* generate_clustered_array(const int n);
 void print_array(int arr[], const int n);
 int find_min(const int arr[], const int n);
 int find_max(const int arr[], const int n);
+void find_min_max(const int arr[], const int n, int* min_val, int* max_val);
 
 // Question (a) : Algorithme naïf en O(n²)
 Pair naive_approach(int S[], const int n);
@@ -20,7 +34,7 @@ Pair naive_approach(int S[], const int n);
 // Question (b) : Algorithme optimisé en O(n)
 Pair optimized_approach(int S[], const int n);
 
-// Fonction de comparaison pour qsort
-int compare_ints(const void* a, const void* b);
+// Référence de (b) par tri en O(n log n): même résultat que optimized_approach
+Pair sorting_approach(int S[], const int n);
 
 #endif // DEUX_ELEMENTS_H
\ No newline at end of file
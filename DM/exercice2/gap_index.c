@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gap_index.h"
+#include "typed_sort.h"
+
+#define GAP_INDEX_INITIAL_CAPACITY 64
+#define NONE (-1)
+
+void gap_index_init(GapIndex* index) {
+    index->nodes = NULL;
+    index->capacity = 0;
+    index->used = 0;
+    index->free_list = NONE;
+    index->root = NONE;
+    index->size = 0;
+    rng_seed(&index->rng, generator_default_seed());
+}
+
+void gap_index_free(GapIndex* index) {
+    free(index->nodes);
+    gap_index_init(index);
+}
+
+static int new_node(GapIndex* index, const int value, const int count) {
+    int node;
+    if (index->free_list != NONE) {
+        node = index->free_list;
+        index->free_list = index->nodes[node].left;
+    } else {
+        if (index->used == index->capacity) {
+            index->capacity = index->capacity > 0 ? 2 * index->capacity : GAP_INDEX_INITIAL_CAPACITY;
+            index->nodes = realloc(index->nodes, index->capacity * sizeof(GapNode));
+        }
+        node = index->used++;
+    }
+
+    GapNode* t = &index->nodes[node];
+    t->value = value;
+    t->count = count;
+    t->priority = (uint32_t)rng_next(&index->rng);
+    t->left = NONE;
+    t->right = NONE;
+    t->min = value;
+    t->max = value;
+    t->best = count >= 2 ? PAIR_KEY(value, value) : PAIR_NONE;
+    return node;
+}
+
+static void release_node(GapIndex* index, const int node) {
+    index->nodes[node].left = index->free_list;
+    index->free_list = node;
+}
+
+// Recalcule le résumé d'un noeud à partir de ceux de ses fils
+static void update(GapNode nodes[], const int node) {
+    GapNode* t = &nodes[node];
+    uint64_t best = t->count >= 2 ? PAIR_KEY(t->value, t->value) : PAIR_NONE;
+    t->min = t->value;
+    t->max = t->value;
+
+    if (t->left != NONE) {
+        const GapNode* l = &nodes[t->left];
+        t->min = l->min;
+        best = min_key(best, min_key(l->best, PAIR_KEY(l->max, t->value)));
+    }
+    if (t->right != NONE) {
+        const GapNode* r = &nodes[t->right];
+        t->max = r->max;
+        best = min_key(best, min_key(r->best, PAIR_KEY(t->value, r->min)));
+    }
+    t->best = best;
+}
+
+static int rotate_right(GapNode nodes[], const int node) {
+    const int child = nodes[node].left;
+    nodes[node].left = nodes[child].right;
+    nodes[child].right = node;
+    update(nodes, node);
+    update(nodes, child);
+    return child;
+}
+
+static int rotate_left(GapNode nodes[], const int node) {
+    const int child = nodes[node].right;
+    nodes[node].right = nodes[child].left;
+    nodes[child].left = node;
+    update(nodes, node);
+    update(nodes, child);
+    return child;
+}
+
+static int insert_at(GapIndex* index, const int node, const int value) {
+    if (node == NONE) return new_node(index, value, 1);
+
+    // new_node peut déplacer le tableau: on relit index->nodes après chaque appel
+    if (value == index->nodes[node].value) {
+        index->nodes[node].count++;
+    } else if (value < index->nodes[node].value) {
+        const int child = insert_at(index, index->nodes[node].left, value);
+        index->nodes[node].left = child;
+        if (index->nodes[child].priority > index->nodes[node].priority) {
+            return rotate_right(index->nodes, node);
+        }
+    } else {
+        const int child = insert_at(index, index->nodes[node].right, value);
+        index->nodes[node].right = child;
+        if (index->nodes[child].priority > index->nodes[node].priority) {
+            return rotate_left(index->nodes, node);
+        }
+    }
+    update(index->nodes, node);
+    return node;
+}
+
+// Réunit deux arbres dont toutes les valeurs de a précèdent celles de b
+static int merge_trees(GapNode nodes[], const int a, const int b) {
+    if (a == NONE) return b;
+    if (b == NONE) return a;
+    if (nodes[a].priority > nodes[b].priority) {
+        nodes[a].right = merge_trees(nodes, nodes[a].right, b);
+        update(nodes, a);
+        return a;
+    }
+    nodes[b].left = merge_trees(nodes, a, nodes[b].left);
+    update(nodes, b);
+    return b;
+}
+
+static int delete_at(GapIndex* index, const int node, const int value, int* found) {
+    if (node == NONE) return NONE;
+
+    GapNode* nodes = index->nodes;
+    if (value == nodes[node].value) {
+        *found = 1;
+        if (--nodes[node].count == 0) {
+            const int replacement = merge_trees(nodes, nodes[node].left, nodes[node].right);
+            release_node(index, node);
+            return replacement;
+        }
+    } else if (value < nodes[node].value) {
+        nodes[node].left = delete_at(index, nodes[node].left, value, found);
+    } else {
+        nodes[node].right = delete_at(index, nodes[node].right, value, found);
+    }
+    update(nodes, node);
+    return node;
+}
+
+void gap_index_insert(GapIndex* index, const int value) {
+    index->root = insert_at(index, index->root, value);
+    index->size++;
+}
+
+int gap_index_delete(GapIndex* index, const int value) {
+    int found = 0;
+    index->root = delete_at(index, index->root, value, &found);
+    index->size -= found;
+    return found;
+}
+
+// Résumés d'un arbre construit d'un bloc, fils avant parents
+static void update_all(GapNode nodes[], const int node) {
+    if (node == NONE) return;
+    update_all(nodes, nodes[node].left);
+    update_all(nodes, nodes[node].right);
+    update(nodes, node);
+}
+
+// Arbre-tas d'un tableau trié en O(k): les valeurs arrivent dans l'ordre,
+// la pile garde la branche droite; chaque noeud y dépile ceux de priorité
+// plus faible, qui deviennent son fils gauche.
+static int build_sorted(GapIndex* index, const int sorted[], const int k) {
+    int* stack = malloc(k * sizeof(int));
+    int top = 0;
+
+    for (int i = 0; i < k;) {
+        int j = i + 1;
+        while (j < k && sorted[j] == sorted[i]) j++;
+
+        const int node = new_node(index, sorted[i], j - i);
+        GapNode* nodes = index->nodes;
+        int last = NONE;
+        while (top > 0 && nodes[stack[top - 1]].priority < nodes[node].priority) {
+            last = stack[--top];
+        }
+        nodes[node].left = last;
+        if (top > 0) nodes[stack[top - 1]].right = node;
+        stack[top++] = node;
+        i = j;
+    }
+
+    const int root = top > 0 ? stack[0] : NONE;
+    free(stack);
+    update_all(index->nodes, root);
+    return root;
+}
+
+static int* sorted_copy(const int values[], const int k) {
+    int* sorted = malloc(k * sizeof(int));
+    memcpy(sorted, values, k * sizeof(int));
+    sort_int32(sorted, k);
+    return sorted;
+}
+
+void gap_index_insert_batch(GapIndex* index, const int values[], const int k) {
+    if (k <= 0) return;
+    int* sorted = sorted_copy(values, k);
+
+    if (index->root == NONE) {
+        index->root = build_sorted(index, sorted, k);
+        index->size = k;
+    } else {
+        for (int i = 0; i < k; i++) {
+            gap_index_insert(index, sorted[i]);
+        }
+    }
+    free(sorted);
+}
+
+int gap_index_delete_batch(GapIndex* index, const int values[], const int k) {
+    if (k <= 0) return 0;
+    int* sorted = sorted_copy(values, k);
+
+    int removed = 0;
+    for (int i = 0; i < k; i++) {
+        removed += gap_index_delete(index, sorted[i]);
+    }
+    free(sorted);
+    return removed;
+}
+
+Pair gap_index_min_pair(const GapIndex* index) {
+    Pair result = {0, 0, -1};
+    if (index->root == NONE || index->nodes[index->root].best == PAIR_NONE) return result;
+
+    const uint64_t best = index->nodes[index->root].best;
+    result.x = (int)((uint32_t)best ^ 0x80000000u);
+    result.y = (int)(result.x + (int64_t)(best >> 32));
+    result.diff = (double)(best >> 32);
+    return result;
+}
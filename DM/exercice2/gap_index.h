@@ -0,0 +1,56 @@
+#ifndef GAP_INDEX_H
+#define GAP_INDEX_H
+
+#include <stdint.h>
+#include "deux_elements.h"
+#include "generator.h"
+
+// Index dynamique de la paire la plus proche (gap_index.c): un multiensemble
+// d'entiers qui accepte insertions et suppressions en O(log n) (en moyenne)
+// et donne à tout moment, en O(1), la paire d'écart minimal, la même que
+// optimized_approach sur les valeurs présentes.
+//
+// Arbre-tas (treap) sur les valeurs, chaque noeud gardant une valeur et son
+// nombre d'occurrences. Chaque noeud résume aussi son sous-arbre: minimum,
+// maximum et meilleure paire (clé PAIR_KEY). La meilleure paire d'un noeud
+// est la meilleure de ses deux fils, des deux paires qui le relient à eux
+// (maximum de gauche, minimum de droite) et de (valeur, valeur) si elle est
+// répétée. Une mise à jour ne recalcule que le chemin jusqu'à la racine.
+typedef struct {
+    int value;
+    int count;
+    uint32_t priority;
+    int left;
+    int right;
+    int min;
+    int max;
+    uint64_t best;
+} GapNode;
+
+// Les noeuds vivent dans un tableau (indices, -1: aucun); les noeuds libérés
+// sont chaînés par `left` et réutilisés
+typedef struct {
+    GapNode* nodes;
+    int capacity;
+    int used;
+    int free_list;
+    int root;
+    long size;
+    Rng rng;
+} GapIndex;
+
+void gap_index_init(GapIndex* index);
+void gap_index_free(GapIndex* index);
+void gap_index_insert(GapIndex* index, int value);
+// Retire une occurrence de value; 0 si elle est absente
+int gap_index_delete(GapIndex* index, int value);
+// Lots: les valeurs sont triées d'abord, pour que les mises à jour voisines
+// suivent les mêmes chemins de l'arbre. Un index vide est construit
+// directement à partir du lot trié, en O(k) après le tri.
+void gap_index_insert_batch(GapIndex* index, const int values[], int k);
+// Nombre de valeurs effectivement retirées
+int gap_index_delete_batch(GapIndex* index, const int values[], int k);
+// Paire d'écart minimal ({0, 0, -1} s'il y a moins de deux valeurs)
+Pair gap_index_min_pair(const GapIndex* index);
+
+#endif // GAP_INDEX_H